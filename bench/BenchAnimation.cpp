@@ -0,0 +1,54 @@
+#include "Benchmark.h"
+#include "BenchCommon.h"
+#include "../include/animation.h"
+#include "../include/Systems.h"
+#include "../include/World.h"
+
+// Fill the manager with playing, looping 8-frame animations with staggered clocks
+static void CreateAnimations(size_t count) {
+    AnimationManager::ClearAnimations();
+    BenchRandom random;
+    for (size_t i = 0; i < count; i++) {
+        int anim = AnimationManager::CreateAnimation(true);
+        for (GLuint frame = 1; frame <= 8; frame++) {
+            AnimationManager::AddFrameToAnimation(anim, frame, 0.1f);
+        }
+        AnimationManager::animations[anim].currentTime = random.Next(0.0f, 0.1f);
+        AnimationManager::PlayAnimation(anim);
+    }
+}
+
+// Animation::Update over every animation, args are {animations, job workers}
+static void BM_UpdateAllAnimations(bench::State& state) {
+    UseJobWorkers(static_cast<unsigned>(state.range(1)));
+    CreateAnimations(state.range(0));
+
+    for (auto _ : state) {
+        AnimationManager::UpdateAllAnimations(1.0f / 60.0f);
+        bench::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    AnimationManager::ClearAnimations();
+}
+BENCHMARK(BM_UpdateAllAnimations)
+    ->Args({256, 0})->Args({4096, 0})->Args({65536, 0})
+    ->Args({4096, DefaultWorkers()})->Args({65536, DefaultWorkers()});
+
+// ECS path: one animation per entity, advanced and written into the sprite textures
+static void BM_AnimationSystem(bench::State& state) {
+    UseJobWorkers(0);
+    CreateAnimations(state.range(0));
+    World scene;
+    FillSprites(scene.sprites, state.range(0));
+    for (size_t i = 0; i < scene.sprites.size(); i++) {
+        scene.components.Add(scene.sprites.HandleAt(i), AnimationComponent{static_cast<int>(i), true});
+    }
+
+    for (auto _ : state) {
+        AnimationSystem::Update(scene, 1.0f / 60.0f);
+        frameArena.Reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    AnimationManager::ClearAnimations();
+}
+BENCHMARK(BM_AnimationSystem)->RangeMultiplier(8)->Range(64, 32768);
@@ -0,0 +1,75 @@
+#include "Benchmark.h"
+#include "BenchCommon.h"
+#include "../include/Collision.h"
+#include "../include/FrameArena.h"
+#include "../include/Systems.h"
+#include "../include/World.h"
+
+// One query box against every sprite, the per-sprite cost of FindCollision style scripts
+static void BM_FindAllCollisions(bench::State& state) {
+    SpriteStore sprites;
+    float side = FillSprites(sprites, state.range(0));
+    BenchRandom random(99u);
+    FrameArena arena;
+
+    for (auto _ : state) {
+        AABB box(random.Next(0.0f, side), random.Next(0.0f, side), 64.0f, 64.0f);
+        std::span<int> hits = CollisionManager::FindAllCollisions(box, sprites, arena);
+        bench::DoNotOptimize(hits.data());
+        arena.Reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FindAllCollisions)->RangeMultiplier(8)->Range(64, 32768);
+
+// All pairs, quadratic in the sprite count
+static void BM_GetAllCollisions(bench::State& state) {
+    SpriteStore sprites;
+    FillSprites(sprites, state.range(0));
+    FrameArena arena;
+    size_t pairs = 0;
+
+    for (auto _ : state) {
+        std::span<CollisionInfo> collisions = CollisionManager::GetAllCollisions(sprites, arena);
+        pairs = collisions.size();
+        bench::DoNotOptimize(collisions.data());
+        arena.Reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["pairs"] = static_cast<double>(pairs);
+}
+BENCHMARK(BM_GetAllCollisions)->RangeMultiplier(4)->Range(64, 4096);
+
+// Screen-sized culling query, as done for the render list every frame
+static void BM_FindInRegion(bench::State& state) {
+    SpriteStore sprites;
+    float side = FillSprites(sprites, state.range(0));
+    AABB region(side * 0.25f, side * 0.25f, 1920.0f, 1080.0f);
+    std::vector<int> visible;
+
+    for (auto _ : state) {
+        CollisionManager::FindInRegion(region, sprites, visible);
+        bench::DoNotOptimize(visible.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["visible"] = static_cast<double>(visible.size());
+}
+BENCHMARK(BM_FindInRegion)->RangeMultiplier(8)->Range(64, 32768);
+
+// Collision system pass over sensor colliders. Solid pairs would be pushed apart and
+// change the layout between iterations, so only the pair tests and contact list are timed.
+static void BM_CollisionSystem(bench::State& state) {
+    World scene;
+    FillSprites(scene.sprites, state.range(0));
+    for (size_t i = 0; i < scene.sprites.size(); i++) {
+        scene.components.Add(scene.sprites.HandleAt(i), Collider{false});
+    }
+
+    for (auto _ : state) {
+        CollisionSystem::Update(scene);
+        frameArena.Reset();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["contacts"] = static_cast<double>(CollisionSystem::Contacts().size());
+}
+BENCHMARK(BM_CollisionSystem)->RangeMultiplier(4)->Range(64, 4096);
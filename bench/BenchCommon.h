@@ -0,0 +1,52 @@
+#ifndef QENGINE_BENCHCOMMON_H
+#define QENGINE_BENCHCOMMON_H
+
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include "../include/SpriteStore.h"
+#include "../include/JobSystem.h"
+
+// Deterministic LCG so every run and every commit benchmarks the same scene
+struct BenchRandom {
+    uint32_t state;
+
+    explicit BenchRandom(uint32_t seed = 12345u) : state(seed) {}
+
+    float Next(float low, float high) {
+        state = state * 1664525u + 1013904223u;
+        return low + (high - low) * static_cast<float>(state >> 8) / 16777216.0f;
+    }
+};
+
+// Scatter 'count' 32x32 sprites over a square field that grows with the count,
+// keeping the average number of overlaps per sprite constant across scales
+inline float FillSprites(SpriteStore& sprites, size_t count, uint32_t seed = 12345u) {
+    BenchRandom random(seed);
+    float side = std::sqrt(static_cast<float>(count)) * 96.0f;
+    for (size_t i = 0; i < count; i++) {
+        Sprite sprite{1, random.Next(0.0f, side), random.Next(0.0f, side), 32.0f, 32.0f};
+        sprites.Insert(sprite);
+    }
+    return side;
+}
+
+// Restart the job system with the given worker count, 0 leaves it stopped so
+// ParallelFor runs inline on the benchmark thread
+inline void UseJobWorkers(unsigned workers) {
+    if (JobSystem::IsRunning() && JobSystem::WorkerCount() == workers) {
+        return;
+    }
+    JobSystem::Shutdown();
+    if (workers > 0) {
+        JobSystem::Initialize(workers);
+    }
+}
+
+// Worker count the engine picks by default
+inline unsigned DefaultWorkers() {
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 1;
+}
+
+#endif //QENGINE_BENCHCOMMON_H
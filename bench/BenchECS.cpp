@@ -0,0 +1,69 @@
+#include "Benchmark.h"
+#include "BenchCommon.h"
+#include "../include/World.h"
+
+// Every entity gets a Velocity, every other one a Collider too
+static void FillMovers(World& scene, size_t count) {
+    FillSprites(scene.sprites, count);
+    for (size_t i = 0; i < scene.sprites.size(); i++) {
+        Entity entity = scene.sprites.HandleAt(i);
+        scene.components.Add(entity, Velocity{1.0f, 2.0f});
+        if (i % 2 == 0) {
+            scene.components.Add(entity, Collider{true});
+        }
+    }
+}
+
+// Entities with both components, found the slow way to check the cached view against
+static size_t CountMatches(World& scene) {
+    size_t matches = 0;
+    for (Entity entity : scene.components.Pool<Velocity>().Entities()) {
+        matches += scene.components.Has<Collider>(entity) ? 1 : 0;
+    }
+    return matches;
+}
+
+// Two-component view, args are {entities, churn}. With churn 0 the cached match list is
+// reused every iteration; with churn 1 one entity's Collider is added or removed first,
+// so every iteration invalidates the view and rebuilds it. Fails if the view ever
+// disagrees with a direct membership count or hands out the wrong component.
+static void BM_EachVelocityCollider(bench::State& state) {
+    World scene;
+    FillMovers(scene, static_cast<size_t>(state.range(0)));
+    bool churn = state.range(1) != 0;
+    Entity toggled = scene.sprites.HandleAt(1);
+
+    for (auto _ : state) {
+        if (churn) {
+            if (!scene.components.Remove<Collider>(toggled)) {
+                scene.components.Add(toggled, Collider{false});
+            }
+        }
+
+        size_t visited = 0;
+        float speed = 0.0f;
+        scene.components.Each<Velocity, Collider>([&](Entity, Velocity& velocity, Collider& collider) {
+            speed += collider.solid ? velocity.x : velocity.y;
+            visited++;
+        });
+        bench::DoNotOptimize(speed);
+
+        if (churn) {
+            state.PauseTiming();
+            bool consistent = visited == CountMatches(scene);
+            scene.components.Each<Velocity, Collider>([&](Entity entity, Velocity& velocity, Collider& collider) {
+                consistent = consistent && &velocity == scene.components.Get<Velocity>(entity) &&
+                             &collider == scene.components.Get<Collider>(entity);
+            });
+            state.ResumeTiming();
+            if (!consistent) {
+                state.SkipWithError("cached view out of date");
+                break;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EachVelocityCollider)
+    ->Args({1024, 0})->Args({32768, 0})
+    ->Args({1024, 1})->Args({32768, 1});
@@ -0,0 +1,108 @@
+#include "Benchmark.h"
+#include "BenchCommon.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// ParallelFor scaling over a light per-element kernel, args are {elements, job workers}.
+// Workers 0 runs inline, so the ratio against it is the speedup minus scheduling overhead.
+static void BM_ParallelFor(bench::State& state) {
+    UseJobWorkers(static_cast<unsigned>(state.range(1)));
+    size_t count = static_cast<size_t>(state.range(0));
+    std::vector<float> input(count), output(count);
+    BenchRandom random;
+    for (float& value : input) {
+        value = random.Next(0.0f, 100.0f);
+    }
+    const float* in = input.data();
+    float* out = output.data();
+
+    for (auto _ : state) {
+        JobSystem::ParallelFor(count, 1024, [in, out](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                out[i] = std::sqrt(in[i]) * 0.5f + in[i] * 0.25f;
+            }
+        });
+        bench::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * 2 * sizeof(float));
+}
+
+// Element counts against 0, 1, 2, 4... workers, plus the engine default (cores - 1)
+// and one worker per core
+static void RegisterParallelFor() {
+    bench::Benchmark* benchmark = bench::RegisterBenchmark("BM_ParallelFor", BM_ParallelFor);
+    unsigned hardware = std::max(std::thread::hardware_concurrency(), 1u);
+    std::vector<unsigned> sweep;
+    for (unsigned workers = 1; workers < hardware; workers *= 2) {
+        sweep.push_back(workers);
+    }
+    sweep.push_back(DefaultWorkers());
+    sweep.push_back(hardware);
+    std::sort(sweep.begin(), sweep.end());
+    sweep.erase(std::unique(sweep.begin(), sweep.end()), sweep.end());
+
+    for (int64_t count : {1 << 14, 1 << 18, 1 << 22}) {
+        benchmark->Args({count, 0});
+        for (unsigned workers : sweep) {
+            benchmark->Args({count, workers});
+        }
+    }
+}
+static const bool parallelForRegistered = (RegisterParallelFor(), true);
+
+// Cost of an empty job round trip: submit, run on a worker, wait
+static void BM_JobRoundTrip(bench::State& state) {
+    UseJobWorkers(static_cast<unsigned>(state.range(0)));
+
+    for (auto _ : state) {
+        Job* job = JobSystem::CreateJob([] {});
+        JobSystem::Run(job);
+        JobSystem::Wait(job);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_JobRoundTrip)->Arg(1)->Arg(4);
+
+// Each submitting thread builds a root with PARENT_JOBS children that have a child of their
+// own, all created before the root is queued. That is more jobs in flight per thread than one
+// job pool block (4096) holds, so the pool has to grow rather than recycle a live slot.
+// Args are {submitting threads, job workers}. Fails if any job is lost or run twice.
+static const int PARENT_JOBS = 3000;
+
+static void SubmitJobTree(std::atomic<int>* executed) {
+    Job* root = JobSystem::CreateJob([] {});
+    for (int i = 0; i < PARENT_JOBS; i++) {
+        Job* parent = JobSystem::CreateJob([executed] { executed->fetch_add(1, std::memory_order_relaxed); }, root);
+        JobSystem::Run(JobSystem::CreateJob([executed] { executed->fetch_add(1, std::memory_order_relaxed); }, parent));
+        JobSystem::Run(parent);
+    }
+    JobSystem::Run(root);
+    JobSystem::Wait(root);
+}
+
+static void BM_JobPoolOverflow(bench::State& state) {
+    UseJobWorkers(static_cast<unsigned>(state.range(1)));
+    int submitters = static_cast<int>(state.range(0));
+    std::atomic<int> executed{0};
+
+    for (auto _ : state) {
+        executed.store(0, std::memory_order_relaxed);
+        std::vector<std::thread> threads;
+        for (int t = 1; t < submitters; t++) {
+            threads.emplace_back(SubmitJobTree, &executed);
+        }
+        SubmitJobTree(&executed);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        if (executed.load() != submitters * PARENT_JOBS * 2) {
+            state.SkipWithError("job count mismatch");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * submitters * (PARENT_JOBS * 2 + 1));
+}
+BENCHMARK(BM_JobPoolOverflow)->Args({1, 4})->Args({4, 4});
@@ -0,0 +1,303 @@
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+#include <lualib.h>
+}
+#include "../include/LuaCompat.h"
+#include "Benchmark.h"
+#include "BenchCommon.h"
+#include "../include/LuaScripting.h"
+#include "../include/FrameArena.h"
+#include "../include/World.h"
+#include "../include/CoroutineScheduler.h"
+#include "../include/ScriptSystem.h"
+#include "../include/ScriptGroups.h"
+#include <filesystem>
+#include <fstream>
+
+// Script side of the binding benchmarks, each function makes n binding calls
+static const char* BENCH_SCRIPT = R"lua(
+function BenchSpriteCount(n)
+    local count = 0
+    for i = 1, n do
+        count = GetSpriteCount()
+    end
+    return count
+end
+
+function BenchGetPosition(n)
+    local handles = benchHandles
+    local x = 0
+    for i = 1, n do
+        local px, py = GetSpritePosition(handles[i])
+        x = x + px
+    end
+    return x
+end
+
+function BenchMove(n)
+    local handles = benchHandles
+    for i = 1, n do
+        MoveTexture(handles[i], i, i)
+    end
+end
+
+local proxies = {}
+function BenchProxyMove(n)
+    if #proxies ~= n then
+        proxies = {}
+        for i = 1, n do
+            proxies[i] = GetSprite(benchHandles[i])
+        end
+    end
+    for i = 1, n do
+        local s = proxies[i]
+        s.x = s.x + 1
+    end
+end
+
+local batchXs, batchYs = {}, {}
+function BenchMoveBatch(n)
+    if #batchXs ~= n then
+        batchXs, batchYs = {}, {}
+        for i = 1, n do
+            batchXs[i] = i
+            batchYs[i] = i
+        end
+    end
+    MoveTextures(benchHandles, batchXs, batchYs)
+end
+
+function BenchSetColor(n)
+    local handles = benchHandles
+    for i = 1, n do
+        SetSpriteColor(handles[i], 1, 0.5, 0.25, 1)
+    end
+end
+
+function BenchFFIMove(n)
+    local sprites = SpriteArrays()
+    local x, y = sprites.x, sprites.y
+    for i = 0, n - 1 do
+        x[i] = i
+        y[i] = i
+    end
+end
+
+function BenchStartCoroutines(n)
+    for i = 1, n do
+        StartCoroutine(function()
+            local frames = 1 + i % 8
+            while true do
+                WaitFrames(frames)
+            end
+        end)
+    end
+end
+
+local Counter = {}
+function Counter:OnStart()
+    self.time = 0
+end
+function Counter:OnUpdate(dt)
+    self.time = self.time + dt
+end
+
+function BenchAttachScripts(n)
+    for i = 1, n do
+        AttachScript(benchHandles[i], Counter)
+    end
+end
+
+function BenchFindAll(n)
+    local handles = benchHandles
+    local hits, found = 0, {}
+    for i = 1, n do
+        hits = hits + #FindAllCollisions(handles[i], found)
+    end
+    return hits
+end
+)lua";
+
+// One VM for the whole run with the engine bindings registered and the bench script loaded
+static bool PrepareLua(bench::State& state, size_t sprites) {
+    static bool loaded = false;
+    if (!loaded) {
+        initLua();
+        registerLuaFunctions();
+        if (luaL_dostring(L, BENCH_SCRIPT) != LUA_OK) {
+            state.SkipWithError(lua_tostring(L, -1));
+            lua_pop(L, 1);
+            return false;
+        }
+        loaded = true;
+    }
+
+    world.Clear();
+    FillSprites(world.sprites, sprites);
+    lua_createtable(L, static_cast<int>(sprites), 0);
+    for (size_t i = 0; i < sprites; i++) {
+        lua_pushinteger(L, static_cast<lua_Integer>(world.sprites.HandleAt(i)));
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
+    }
+    lua_setglobal(L, "benchHandles");
+    return true;
+}
+
+// Time calls of a bench script function, args are {sprites}, one binding call per sprite
+static void RunLuaBenchmark(bench::State& state, const char* function) {
+    int64_t calls = state.range(0);
+    if (!PrepareLua(state, static_cast<size_t>(calls))) {
+        return;
+    }
+
+    for (auto _ : state) {
+        lua_getglobal(L, function);
+        lua_pushinteger(L, calls);
+        if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+            state.SkipWithError(lua_tostring(L, -1));
+            lua_pop(L, 1);
+            break;
+        }
+        frameArena.Reset();
+    }
+    state.SetItemsProcessed(state.iterations() * calls);
+    world.Clear();
+}
+
+// Binding call overhead with no sprite lookup
+static void BM_LuaGetSpriteCount(bench::State& state) {
+    RunLuaBenchmark(state, "BenchSpriteCount");
+}
+BENCHMARK(BM_LuaGetSpriteCount)->Arg(1024);
+
+static void BM_LuaGetSpritePosition(bench::State& state) {
+    RunLuaBenchmark(state, "BenchGetPosition");
+}
+BENCHMARK(BM_LuaGetSpritePosition)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_LuaMoveTexture(bench::State& state) {
+    RunLuaBenchmark(state, "BenchMove");
+}
+BENCHMARK(BM_LuaMoveTexture)->RangeMultiplier(8)->Range(64, 32768);
+
+// Read-modify-write of x through cached sprite proxies
+static void BM_LuaProxyMove(bench::State& state) {
+    RunLuaBenchmark(state, "BenchProxyMove");
+}
+BENCHMARK(BM_LuaProxyMove)->RangeMultiplier(8)->Range(64, 32768);
+
+// Same writes as BM_LuaMoveTexture in a single MoveTextures call
+static void BM_LuaMoveTextures(bench::State& state) {
+    RunLuaBenchmark(state, "BenchMoveBatch");
+}
+BENCHMARK(BM_LuaMoveTextures)->RangeMultiplier(8)->Range(64, 32768);
+
+static void BM_LuaSetSpriteColor(bench::State& state) {
+    RunLuaBenchmark(state, "BenchSetColor");
+}
+BENCHMARK(BM_LuaSetSpriteColor)->RangeMultiplier(8)->Range(64, 32768);
+
+#if USE_LUAJIT
+// Same writes as BM_LuaMoveTexture through the FFI column views, no binding calls
+static void BM_LuaFFIMove(bench::State& state) {
+    RunLuaBenchmark(state, "BenchFFIMove");
+}
+BENCHMARK(BM_LuaFFIMove)->RangeMultiplier(8)->Range(64, 32768);
+#endif
+
+// Per-sprite collision query returning a table of handles, quadratic in the sprite count
+static void BM_LuaFindAllCollisions(bench::State& state) {
+    RunLuaBenchmark(state, "BenchFindAll");
+}
+BENCHMARK(BM_LuaFindAllCollisions)->RangeMultiplier(4)->Range(64, 4096);
+
+// One scheduler tick with {coroutines} each sleeping 1 to 8 ticks, about a third are resumed per tick
+static void BM_CoroutineSchedulerTick(bench::State& state) {
+    int64_t count = state.range(0);
+    if (!PrepareLua(state, 0)) {
+        return;
+    }
+    lua_getglobal(L, "BenchStartCoroutines");
+    lua_pushinteger(L, count);
+    if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+        state.SkipWithError(lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return;
+    }
+
+    for (auto _ : state) {
+        CoroutineScheduler::Update(L, 1.0f / 60.0f);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    CoroutineScheduler::Clear(L);
+}
+BENCHMARK(BM_CoroutineSchedulerTick)->RangeMultiplier(8)->Range(64, 32768);
+
+// OnUpdate dispatch for {sprites} scripted entities
+static void BM_ScriptSystemUpdate(bench::State& state) {
+    int64_t count = state.range(0);
+    if (!PrepareLua(state, static_cast<size_t>(count))) {
+        return;
+    }
+    lua_getglobal(L, "BenchAttachScripts");
+    lua_pushinteger(L, count);
+    if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+        state.SkipWithError(lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return;
+    }
+
+    for (auto _ : state) {
+        ScriptSystem::Update(L, world, 1.0f / 60.0f);
+        frameArena.Reset();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    for (size_t i = 0; i < world.sprites.size(); i++) {
+        ScriptSystem::Detach(L, world, world.sprites.HandleAt(i));
+    }
+    world.Clear();
+}
+BENCHMARK(BM_ScriptSystemUpdate)->RangeMultiplier(8)->Range(64, 32768);
+
+// Group script with a fixed amount of pure Lua work per tick and one message to the main VM
+static const char* GROUP_SCRIPT = R"lua(
+function Update(dt)
+    local sum = 0
+    for i = 1, 20000 do
+        sum = sum + math.sin(i * dt)
+    end
+    PostMessage("main", "done", sum)
+end
+)lua";
+
+// One tick of {groups} script groups on {job workers}, 0 workers runs them one after another
+static void BM_ScriptGroups(bench::State& state) {
+    UseJobWorkers(static_cast<unsigned>(state.range(1)));
+    if (!PrepareLua(state, 0)) {
+        return;
+    }
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "qengine_bench_group.lua";
+    {
+        std::ofstream file(path);
+        file << GROUP_SCRIPT;
+    }
+
+    int64_t count = state.range(0);
+    for (int64_t i = 0; i < count; i++) {
+        if (!ScriptGroupManager::Start("group" + std::to_string(i), path.string())) {
+            state.SkipWithError("failed to start script group");
+            ScriptGroupManager::StopAll();
+            return;
+        }
+    }
+
+    for (auto _ : state) {
+        ScriptGroupManager::Update(L, 1.0f / 60.0f);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    ScriptGroupManager::StopAll();
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_ScriptGroups)
+    ->Args({8, 0})->Args({8, DefaultWorkers()})->Args({64, 0})->Args({64, DefaultWorkers()});
@@ -0,0 +1,23 @@
+#include "Benchmark.h"
+#include "../include/JobSystem.h"
+#include "../include/LuaScripting.h"
+#include "../include/TextureLoader.h"
+#include "../include/Timestep.h"
+
+// Engine globals that main.cpp owns in the QEngine executable
+FixedTimestep simulationTimestep(60.0f, 5);
+
+// Usage: QEngineBench [--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>]
+//                     [--benchmark_out=<file.json>] [--benchmark_list_tests]
+// Runs without a window or GL context: textures stay headless and nothing touches the GPU.
+int main(int argc, char** argv) {
+    SetHeadlessTextures(true);
+
+    int result = bench::RunSpecifiedBenchmarks(argc, argv);
+
+    JobSystem::Shutdown();
+    if (L) {
+        shutdownLua();
+    }
+    return result;
+}
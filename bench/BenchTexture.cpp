@@ -0,0 +1,111 @@
+#include "Benchmark.h"
+#include "BenchCommon.h"
+#include "../include/TextureLoader.h"
+#include "stb_image.h"
+#include <png.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Sprite-like RGBA test image: smooth gradients with some noise, so it compresses like real art
+static std::vector<unsigned char> EncodeTestPNG(int size) {
+    std::vector<unsigned char> pixels(static_cast<size_t>(size) * size * 4);
+    BenchRandom random(static_cast<uint32_t>(size));
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            unsigned char* p = &pixels[(static_cast<size_t>(y) * size + x) * 4];
+            p[0] = static_cast<unsigned char>(x * 255 / size);
+            p[1] = static_cast<unsigned char>(y * 255 / size);
+            p[2] = static_cast<unsigned char>(random.Next(0.0f, 64.0f));
+            p[3] = (x / 8 + y / 8) % 5 == 0 ? 0 : 255;
+        }
+    }
+
+    std::vector<unsigned char> encoded;
+    png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    png_infop info = png_create_info_struct(png);
+    if (setjmp(png_jmpbuf(png))) {
+        png_destroy_write_struct(&png, &info);
+        return {};
+    }
+    png_set_write_fn(png, &encoded, [](png_structp png, png_bytep data, png_size_t length) {
+        auto* out = static_cast<std::vector<unsigned char>*>(png_get_io_ptr(png));
+        out->insert(out->end(), data, data + length);
+    }, nullptr);
+    png_set_IHDR(png, info, size, size, 8, PNG_COLOR_TYPE_RGBA, PNG_INTERLACE_NONE,
+                 PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(png, info);
+    for (int y = 0; y < size; y++) {
+        png_write_row(png, &pixels[static_cast<size_t>(y) * size * 4]);
+    }
+    png_write_end(png, nullptr);
+    png_destroy_write_struct(&png, &info);
+    return encoded;
+}
+
+// Write the test image once per size, LoadTexture only takes paths
+static std::string TestPNGPath(int size) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                 ("qengine_bench_" + std::to_string(size) + ".png");
+    if (!std::filesystem::exists(path)) {
+        std::vector<unsigned char> encoded = EncodeTestPNG(size);
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+    }
+    return path.string();
+}
+
+// stb_image decode from memory, the CPU half of LoadTexture without the file read
+static void BM_DecodePNG(bench::State& state) {
+    int size = static_cast<int>(state.range(0));
+    std::vector<unsigned char> encoded = EncodeTestPNG(size);
+    if (encoded.empty()) {
+        state.SkipWithError("PNG encode failed");
+        return;
+    }
+
+    for (auto _ : state) {
+        int width, height, channels;
+        unsigned char* pixels = stbi_load_from_memory(encoded.data(), static_cast<int>(encoded.size()),
+                                                      &width, &height, &channels, 0);
+        bench::DoNotOptimize(pixels);
+        stbi_image_free(pixels);
+    }
+    state.SetBytesProcessed(state.iterations() * size * size * 4);
+    state.counters["png_bytes"] = static_cast<double>(encoded.size());
+}
+BENCHMARK(BM_DecodePNG)->RangeMultiplier(4)->Range(16, 1024);
+
+// Same decode as LoadTexture's PNG path, file read included
+static void BM_DecodePNGFile(bench::State& state) {
+    int size = static_cast<int>(state.range(0));
+    std::string path = TestPNGPath(size);
+
+    for (auto _ : state) {
+        int width, height, channels;
+        unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 0);
+        if (!pixels) {
+            state.SkipWithError(stbi_failure_reason());
+            return;
+        }
+        bench::DoNotOptimize(pixels);
+        stbi_image_free(pixels);
+    }
+    state.SetBytesProcessed(state.iterations() * size * size * 4);
+}
+BENCHMARK(BM_DecodePNGFile)->RangeMultiplier(4)->Range(16, 1024);
+
+// LoadTexture/ReleaseTexture with headless textures: header probe and id bookkeeping only
+static void BM_LoadTextureHeadless(bench::State& state) {
+    std::string path = TestPNGPath(static_cast<int>(state.range(0)));
+    SetHeadlessTextures(true);
+
+    for (auto _ : state) {
+        GLuint texture = LoadTexture(path);
+        bench::DoNotOptimize(texture);
+        ReleaseTexture(texture);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LoadTextureHeadless)->Arg(64)->Arg(1024);
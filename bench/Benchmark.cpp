@@ -0,0 +1,413 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+namespace {
+
+// Upper bound on the calibrated iteration count
+const int64_t MAX_ITERATIONS = 1000000000;
+
+std::vector<std::unique_ptr<Benchmark>>& Registry() {
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+double RealSeconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+// CPU time of the calling thread, so job workers spinning elsewhere don't inflate it
+double CpuSeconds() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+#else
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+std::string JsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    out += buffer;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+std::string HostName() {
+#if defined(__unix__) || defined(__APPLE__)
+    char buffer[256] = {};
+    if (gethostname(buffer, sizeof(buffer) - 1) == 0) {
+        return buffer;
+    }
+#endif
+    const char* name = std::getenv("COMPUTERNAME");
+    return name ? name : "unknown";
+}
+
+std::string LocalDate() {
+    std::time_t now = std::time(nullptr);
+    char buffer[64];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+    return buffer;
+}
+
+struct Options {
+    std::string filter = ".";
+    double minTime = 0.5;
+    std::string outPath;
+    bool listOnly = false;
+};
+
+struct Result {
+    std::string name;
+    int64_t iterations = 0;
+    double realNs = 0.0;
+    double cpuNs = 0.0;
+    double itemsPerSecond = 0.0;
+    double bytesPerSecond = 0.0;
+    std::string label;
+    std::string error;
+    std::map<std::string, double> counters;
+};
+
+bool StartsWith(const char* arg, const char* flag, const char*& value) {
+    size_t length = std::strlen(flag);
+    if (std::strncmp(arg, flag, length) != 0 || arg[length] != '=') {
+        return false;
+    }
+    value = arg + length + 1;
+    return true;
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* value = nullptr;
+        if (StartsWith(argv[i], "--benchmark_filter", value)) {
+            options.filter = value;
+        } else if (StartsWith(argv[i], "--benchmark_min_time", value)) {
+            // Accepts "0.5" or "0.5s"
+            options.minTime = std::atof(value);
+        } else if (StartsWith(argv[i], "--benchmark_out", value)) {
+            options.outPath = value;
+        } else if (StartsWith(argv[i], "--benchmark_out_format", value)) {
+            if (std::strcmp(value, "json") != 0) {
+                std::cerr << "Only json output is supported" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(argv[i], "--benchmark_list_tests") == 0) {
+            options.listOnly = true;
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << "\n"
+                      << "Usage: " << argv[0] << " [--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>]\n"
+                      << "       [--benchmark_out=<file.json>] [--benchmark_list_tests]"
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string InstanceName(const std::string& name, const std::vector<int64_t>& args) {
+    std::string out = name;
+    for (int64_t arg : args) {
+        out += "/" + std::to_string(arg);
+    }
+    return out;
+}
+
+void WriteJson(std::ostream& out, const char* executable, const std::vector<Result>& results) {
+    out << std::setprecision(10);
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": \"" << JsonEscape(LocalDate()) << "\",\n";
+    out << "    \"host_name\": \"" << JsonEscape(HostName()) << "\",\n";
+    out << "    \"executable\": \"" << JsonEscape(executable) << "\",\n";
+    out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    out << "    \"library_build_type\": \"release\"\n";
+#else
+    out << "    \"library_build_type\": \"debug\"\n";
+#endif
+    out << "  },\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        out << (i ? ",\n" : "\n") << "    {\n";
+        out << "      \"name\": \"" << JsonEscape(result.name) << "\",\n";
+        out << "      \"run_name\": \"" << JsonEscape(result.name) << "\",\n";
+        out << "      \"run_type\": \"iteration\",\n";
+        out << "      \"repetitions\": 1,\n";
+        out << "      \"repetition_index\": 0,\n";
+        out << "      \"threads\": 1,\n";
+        if (!result.error.empty()) {
+            out << "      \"error_occurred\": true,\n";
+            out << "      \"error_message\": \"" << JsonEscape(result.error) << "\",\n";
+        }
+        out << "      \"iterations\": " << result.iterations << ",\n";
+        out << "      \"real_time\": " << result.realNs << ",\n";
+        out << "      \"cpu_time\": " << result.cpuNs << ",\n";
+        out << "      \"time_unit\": \"ns\"";
+        if (result.itemsPerSecond > 0.0) {
+            out << ",\n      \"items_per_second\": " << result.itemsPerSecond;
+        }
+        if (result.bytesPerSecond > 0.0) {
+            out << ",\n      \"bytes_per_second\": " << result.bytesPerSecond;
+        }
+        for (const auto& [name, value] : result.counters) {
+            out << ",\n      \"" << JsonEscape(name) << "\": " << value;
+        }
+        if (!result.label.empty()) {
+            out << ",\n      \"label\": \"" << JsonEscape(result.label) << "\"";
+        }
+        out << "\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+std::string HumanRate(double perSecond, const char* unit) {
+    const char* prefixes[] = {"", "k", "M", "G", "T"};
+    int prefix = 0;
+    while (perSecond >= 1000.0 && prefix < 4) {
+        perSecond /= 1000.0;
+        prefix++;
+    }
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << perSecond << prefixes[prefix] << unit;
+    return out.str();
+}
+
+void PrintResult(const Result& result) {
+    std::cout << std::left << std::setw(44) << result.name << std::right;
+    if (!result.error.empty()) {
+        std::cout << " ERROR: " << result.error << std::endl;
+        return;
+    }
+    std::cout << std::fixed << std::setprecision(0)
+              << std::setw(14) << result.realNs << " ns"
+              << std::setw(14) << result.cpuNs << " ns"
+              << std::setw(12) << result.iterations;
+    if (result.itemsPerSecond > 0.0) {
+        std::cout << "  " << HumanRate(result.itemsPerSecond, " items/s");
+    }
+    if (result.bytesPerSecond > 0.0) {
+        std::cout << "  " << HumanRate(result.bytesPerSecond, "B/s");
+    }
+    for (const auto& [name, value] : result.counters) {
+        std::cout << "  " << name << "=" << std::setprecision(2) << value;
+    }
+    if (!result.label.empty()) {
+        std::cout << "  " << result.label;
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+State::State(int64_t maxIterations, const std::vector<int64_t>& args)
+    : maxIterations(maxIterations), args(args) {}
+
+void State::StartTimer() {
+    realStart = RealSeconds();
+    cpuStart = CpuSeconds();
+    running = true;
+}
+
+void State::StopTimer() {
+    if (!running) {
+        return;
+    }
+    realSeconds += RealSeconds() - realStart;
+    cpuSeconds += CpuSeconds() - cpuStart;
+    running = false;
+}
+
+void State::PauseTiming() {
+    StopTimer();
+}
+
+void State::ResumeTiming() {
+    StartTimer();
+}
+
+Benchmark* Benchmark::Arg(int64_t value) {
+    argSets.push_back({value});
+    return this;
+}
+
+Benchmark* Benchmark::Args(const std::vector<int64_t>& values) {
+    argSets.push_back(values);
+    return this;
+}
+
+Benchmark* Benchmark::RangeMultiplier(int value) {
+    multiplier = std::max(value, 2);
+    return this;
+}
+
+Benchmark* Benchmark::Range(int64_t low, int64_t high) {
+    for (int64_t value = low; value < high; value *= multiplier) {
+        argSets.push_back({value});
+    }
+    argSets.push_back({high});
+    return this;
+}
+
+Benchmark* Benchmark::MinTime(double seconds) {
+    minTime = seconds;
+    return this;
+}
+
+Benchmark* RegisterBenchmark(const char* name, Function function) {
+    Registry().push_back(std::make_unique<Benchmark>(name, function));
+    return Registry().back().get();
+}
+
+class Runner {
+public:
+    // Grow the iteration count until one timed run covers the minimum time
+    static Result Run(const Benchmark& benchmark, const std::vector<int64_t>& args, double defaultMinTime) {
+        double minTime = benchmark.minTime > 0.0 ? benchmark.minTime : defaultMinTime;
+        int64_t iterations = 1;
+
+        while (true) {
+            State state(iterations, args);
+            benchmark.function(state);
+            state.StopTimer();
+
+            if (!state.error.empty()) {
+                Result result;
+                result.name = InstanceName(benchmark.name, args);
+                result.error = state.error;
+                return result;
+            }
+
+            bool done = state.realSeconds >= minTime || iterations >= MAX_ITERATIONS;
+            if (done) {
+                return MakeResult(benchmark, args, state);
+            }
+
+            // Same growth rule as Google Benchmark: aim 40% past the target, at most 10x per step
+            double multiplier = minTime * 1.4 / std::max(state.realSeconds, 1e-9);
+            if (state.realSeconds / minTime <= 0.1) {
+                multiplier = std::min(multiplier, 10.0);
+            }
+            int64_t next = static_cast<int64_t>(std::ceil(iterations * std::max(multiplier, 1.0)));
+            iterations = std::min(std::max(next, iterations + 1), MAX_ITERATIONS);
+        }
+    }
+
+    static int Main(int argc, char** argv) {
+        Options options;
+        if (!ParseOptions(argc, argv, options)) {
+            return 1;
+        }
+
+        std::regex filter;
+        try {
+            filter = std::regex(options.filter);
+        } catch (const std::regex_error& error) {
+            std::cerr << "Invalid --benchmark_filter: " << error.what() << std::endl;
+            return 1;
+        }
+
+        std::vector<std::pair<const Benchmark*, std::vector<int64_t>>> instances;
+        for (const auto& benchmark : Registry()) {
+            std::vector<std::vector<int64_t>> argSets = benchmark->argSets;
+            if (argSets.empty()) {
+                argSets.push_back({});
+            }
+            for (const auto& args : argSets) {
+                if (std::regex_search(InstanceName(benchmark->name, args), filter)) {
+                    instances.emplace_back(benchmark.get(), args);
+                }
+            }
+        }
+
+        if (options.listOnly) {
+            for (const auto& [benchmark, args] : instances) {
+                std::cout << InstanceName(benchmark->name, args) << std::endl;
+            }
+            return 0;
+        }
+
+        std::cout << std::left << std::setw(44) << "Benchmark" << std::right
+                  << std::setw(17) << "Time" << std::setw(17) << "CPU"
+                  << std::setw(12) << "Iterations" << "\n"
+                  << std::string(90, '-') << std::endl;
+
+        std::vector<Result> results;
+        bool failed = false;
+        for (const auto& [benchmark, args] : instances) {
+            results.push_back(Run(*benchmark, args, options.minTime));
+            failed |= !results.back().error.empty();
+            PrintResult(results.back());
+        }
+
+        if (!options.outPath.empty()) {
+            std::ofstream file(options.outPath);
+            if (!file) {
+                std::cerr << "Failed to open benchmark output: " << options.outPath << std::endl;
+                return 1;
+            }
+            WriteJson(file, argv[0], results);
+        }
+        return failed ? 1 : 0;
+    }
+
+private:
+    static Result MakeResult(const Benchmark& benchmark, const std::vector<int64_t>& args, const State& state) {
+        Result result;
+        result.name = InstanceName(benchmark.name, args);
+        result.iterations = state.maxIterations;
+        result.realNs = state.realSeconds * 1e9 / state.maxIterations;
+        result.cpuNs = state.cpuSeconds * 1e9 / state.maxIterations;
+        if (state.itemsProcessed > 0 && state.realSeconds > 0.0) {
+            result.itemsPerSecond = state.itemsProcessed / state.realSeconds;
+        }
+        if (state.bytesProcessed > 0 && state.realSeconds > 0.0) {
+            result.bytesPerSecond = state.bytesProcessed / state.realSeconds;
+        }
+        result.label = state.label;
+        result.counters = state.counters;
+        return result;
+    }
+};
+
+int RunSpecifiedBenchmarks(int argc, char** argv) {
+    return Runner::Main(argc, argv);
+}
+
+} // namespace bench
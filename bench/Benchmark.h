@@ -0,0 +1,128 @@
+#ifndef QENGINE_BENCHMARK_H
+#define QENGINE_BENCHMARK_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Minimal micro-benchmark harness with a Google Benchmark shaped API, so cases read
+// the same and the JSON output works with the usual compare tooling:
+//
+//   static void BM_Thing(bench::State& state) {
+//       Setup(state.range(0));
+//       for (auto _ : state) { bench::DoNotOptimize(Work()); }
+//       state.SetItemsProcessed(state.iterations() * state.range(0));
+//   }
+//   BENCHMARK(BM_Thing)->RangeMultiplier(8)->Range(64, 32768);
+namespace bench {
+
+class State {
+public:
+    State(int64_t maxIterations, const std::vector<int64_t>& args);
+
+    // Range-for over the state runs the timed loop
+    struct [[maybe_unused]] Value {};
+    struct Iterator {
+        State* state;
+        int64_t remaining;
+        bool operator!=(const Iterator&) const {
+            if (remaining > 0) {
+                return true;
+            }
+            state->StopTimer();
+            return false;
+        }
+        Iterator& operator++() { remaining--; return *this; }
+        Value operator*() const { return {}; }
+    };
+    Iterator begin() { StartTimer(); return {this, maxIterations}; }
+    Iterator end() { return {this, 0}; }
+
+    int64_t range(size_t index = 0) const { return args[index]; }
+    int64_t iterations() const { return maxIterations; }
+
+    // Exclude per-iteration setup from the measurement
+    void PauseTiming();
+    void ResumeTiming();
+
+    void SetItemsProcessed(int64_t items) { itemsProcessed = items; }
+    void SetBytesProcessed(int64_t bytes) { bytesProcessed = bytes; }
+    void SetLabel(const std::string& text) { label = text; }
+    void SkipWithError(const std::string& message) { error = message; }
+
+    // Reported as-is next to the timings
+    std::map<std::string, double> counters;
+
+private:
+    friend class Runner;
+
+    void StartTimer();
+    void StopTimer();
+
+    int64_t maxIterations;
+    std::vector<int64_t> args;
+    bool running = false;
+    double realStart = 0.0, cpuStart = 0.0;
+    double realSeconds = 0.0, cpuSeconds = 0.0;
+    int64_t itemsProcessed = 0;
+    int64_t bytesProcessed = 0;
+    std::string label;
+    std::string error;
+};
+
+using Function = void (*)(State&);
+
+// One registered case, expanded into a run per argument set
+class Benchmark {
+public:
+    Benchmark(std::string name, Function function) : name(std::move(name)), function(function) {}
+
+    Benchmark* Arg(int64_t value);
+    Benchmark* Args(const std::vector<int64_t>& values);
+    Benchmark* RangeMultiplier(int multiplier);
+    Benchmark* Range(int64_t low, int64_t high);   // low, low*m, ... , high
+    Benchmark* MinTime(double seconds);
+
+    const std::string& Name() const { return name; }
+
+private:
+    friend class Runner;
+
+    std::string name;
+    Function function;
+    std::vector<std::vector<int64_t>> argSets;
+    int multiplier = 8;
+    double minTime = 0.0;   // 0 uses the command line default
+};
+
+Benchmark* RegisterBenchmark(const char* name, Function function);
+
+// Parse --benchmark_* flags, run the matching cases and write the reports
+int RunSpecifiedBenchmarks(int argc, char** argv);
+
+// Keep the compiler from discarding a result or folding the work away
+template<typename T>
+inline void DoNotOptimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+inline void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+} // namespace bench
+
+#define QE_BENCH_CONCAT_(a, b) a##b
+#define QE_BENCH_CONCAT(a, b) QE_BENCH_CONCAT_(a, b)
+#define BENCHMARK(fn) \
+    static ::bench::Benchmark* QE_BENCH_CONCAT(benchRegistration_, __LINE__) = ::bench::RegisterBenchmark(#fn, fn)
+
+#endif //QENGINE_BENCHMARK_H
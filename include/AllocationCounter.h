@@ -0,0 +1,29 @@
+#ifndef QENGINE_ALLOCATIONCOUNTER_H
+#define QENGINE_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Counts heap allocations made through operator new (see COUNT_ALLOCATIONS in CMake).
+// Lua allocates through its own allocator and is not included.
+class AllocationCounter {
+public:
+    // Process-wide totals
+    static uint64_t TotalAllocations();
+    static uint64_t TotalBytes();
+
+    // Allocations made by the calling thread
+    static uint64_t ThreadAllocations();
+
+    // Bracket a frame on the calling thread, EndFrame returns that frame's allocation count
+    static void BeginFrame();
+    static uint64_t EndFrame();
+    static uint64_t LastFrameAllocations() { return lastFrame; }
+
+    static bool Enabled() { return COUNT_ALLOCATIONS != 0; }
+
+private:
+    static uint64_t lastFrame;
+};
+
+#endif //QENGINE_ALLOCATIONCOUNTER_H
@@ -1,5 +1,8 @@
 #pragma once
 #include "Sprite.h"
+#include "SpriteStore.h"
+#include "FrameArena.h"
+#include <span>
 #include <vector>
 
 // Axis-Aligned Bounding Box structure
@@ -14,6 +17,11 @@ struct AABB {
     static AABB FromSprite(const Sprite& sprite) {
         return AABB(sprite.x, sprite.y, sprite.width, sprite.height);
     }
+
+    // Create AABB from a dense index in the sprite store
+    static AABB FromStore(const SpriteStore& sprites, size_t index) {
+        return AABB(sprites.X()[index], sprites.Y()[index], sprites.Width()[index], sprites.Height()[index]);
+    }
     
     // Check if this AABB intersects with another
     bool Intersects(const AABB& other) const {
@@ -72,6 +80,24 @@ public:
     // Resolve collision by pushing sprites apart
     static void ResolveCollision(Sprite& a, Sprite& b, const CollisionInfo& info);
     
+    static void ResolveCollision(SpriteRef a, SpriteRef b, const CollisionInfo& info);
+
     // Check if point is inside sprite
     static bool PointInSprite(float x, float y, const Sprite& sprite);
+
+    // Structure-of-arrays queries over the sprite store. These stream only the position
+    // and extent columns and return dense indices (convert with SpriteStore::HandleAt).
+    static int FindFirstCollision(const AABB& box, const SpriteStore& sprites, int ignoreIndex = -1);
+    static std::vector<int> FindAllCollisions(const AABB& box, const SpriteStore& sprites, int ignoreIndex = -1);
+    static std::vector<CollisionInfo> GetAllCollisions(const SpriteStore& sprites);
+
+    // Same queries with results placed in a frame arena, valid until the arena is reset
+    static std::span<int> FindAllCollisions(const AABB& box, const SpriteStore& sprites, FrameArena& arena, int ignoreIndex = -1);
+    static std::span<CollisionInfo> GetAllCollisions(const SpriteStore& sprites, FrameArena& arena);
+
+    // Dense indices of every sprite overlapping the region
+    static void FindInRegion(const AABB& region, const SpriteStore& sprites, std::vector<int>& out);
+
+    // Same with each sprite's x, y as its center, as the sprite shader draws it. Used for view culling
+    static void FindVisible(const AABB& region, const SpriteStore& sprites, std::vector<int>& out);
 };
\ No newline at end of file
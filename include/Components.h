@@ -0,0 +1,37 @@
+#ifndef QENGINE_COMPONENTS_H
+#define QENGINE_COMPONENTS_H
+
+// Optional per-entity data, stored in the world's component pools.
+// Position, size, texture and tint live in the SpriteStore itself.
+
+// Moved by MovementSystem every tick, in pixels per second
+struct Velocity {
+    float x, y;
+};
+
+// Draw order, higher layers are drawn on top
+struct Layer {
+    int value;
+};
+
+// Takes part in CollisionSystem, solid colliders are pushed apart
+struct Collider {
+    bool solid;
+};
+
+// Sprite texture follows an AnimationManager animation
+struct AnimationComponent {
+    int animIndex;
+    bool advance;   // AnimationSystem advances the animation itself
+};
+
+// Lua script instance, see ScriptSystem. Registry references, LUA_NOREF when the script
+// has no such callback.
+struct ScriptComponent {
+    int instance;
+    int onUpdate;
+    int onCollision;
+    int onDestroy;
+};
+
+#endif //QENGINE_COMPONENTS_H
@@ -0,0 +1,60 @@
+#ifndef QENGINE_COROUTINESCHEDULER_H
+#define QENGINE_COROUTINESCHEDULER_H
+
+#include <cstddef>
+#include <string>
+#include "SlotMap.h"
+
+struct lua_State;
+
+// Script coroutines - all static methods. Each coroutine runs on its own Lua thread
+// until it waits: a timer heap holds Wait(seconds), a tick heap holds WaitFrames(n)
+// and per-signal lists hold WaitUntil(signal), so sleeping coroutines cost nothing
+// and Update resumes only the ones that are due. Time is simulation time, advanced
+// by the fixed step, so waits replay exactly. A plain coroutine.yield() waits one tick.
+class CoroutineScheduler {
+public:
+    // Start the function at stack index -(nargs + 1) with the nargs values above it and
+    // run it until its first wait. Pops them all. The handle is stale once it finishes.
+    static SlotHandle Start(lua_State* L, int nargs);
+
+    // Drop a coroutine without resuming it again. Stopping the running coroutine
+    // takes effect at its next wait.
+    static bool Stop(lua_State* L, SlotHandle handle);
+    static bool IsAlive(SlotHandle handle) { return coroutines.Contains(handle); }
+
+    // Park the running coroutine 'co' before it yields, false if 'co' was not started here
+    static bool WaitSeconds(lua_State* co, double seconds);
+    static bool WaitTicks(lua_State* co, int ticks);
+    static bool WaitSignal(lua_State* co, const std::string& signal);
+
+    // Wake every coroutine waiting on the signal at the next Update, returns how many
+    static int Signal(const std::string& signal);
+
+    // Advance the clock by one fixed step and resume the timers, ticks and signals due
+    static void Update(lua_State* L, float step);
+
+    // Forget every coroutine, call before the VM is closed
+    static void Clear(lua_State* L);
+
+    static size_t Count() { return coroutines.size(); }
+
+private:
+    enum class WaitKind { None, Time, Ticks, Signal };
+
+    struct Coroutine {
+        lua_State* thread;
+        int ref;            // registry reference keeping the thread alive
+        WaitKind wait;
+        bool running;
+        bool stopRequested;
+    };
+
+    static void Resume(lua_State* from, SlotHandle handle, WaitKind expected, int nargs);
+    static void Finish(lua_State* L, SlotHandle handle);
+    static Coroutine* Running(lua_State* co);
+
+    static SlotMap<Coroutine> coroutines;
+};
+
+#endif //QENGINE_COROUTINESCHEDULER_H
@@ -0,0 +1,291 @@
+#ifndef QENGINE_ECS_H
+#define QENGINE_ECS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "SlotMap.h"
+
+// Entities share the sprite handle space: an entity is the SlotHandle of its sprite
+using Entity = SlotHandle;
+
+// Sparse set: entity slot -> dense index, with a packed entity array. Membership
+// checks compare the full handle, so stale generations are rejected.
+class SparseSet {
+public:
+    virtual ~SparseSet() = default;
+
+    int IndexOf(Entity entity) const {
+        uint32_t slot = HandleSlot(entity);
+        if (slot >= sparse.size() || sparse[slot] == NONE || dense[sparse[slot]] != entity) {
+            return -1;
+        }
+        return static_cast<int>(sparse[slot]);
+    }
+
+    bool Contains(Entity entity) const { return IndexOf(entity) >= 0; }
+    const std::vector<Entity>& Entities() const { return dense; }
+    size_t Size() const { return dense.size(); }
+
+    // Bumped whenever membership or dense order changes, cached views compare it
+    uint64_t Version() const { return version; }
+
+    virtual bool Remove(Entity entity) = 0;
+    virtual void Clear() = 0;
+
+protected:
+    uint32_t Emplace(Entity entity) {
+        uint32_t slot = HandleSlot(entity);
+        if (slot >= sparse.size()) {
+            sparse.resize(slot + 1, NONE);
+        }
+        sparse[slot] = static_cast<uint32_t>(dense.size());
+        dense.push_back(entity);
+        version++;
+        return sparse[slot];
+    }
+
+    // Swap-remove bookkeeping, 'removed' is the dense index the caller must fill from the back
+    bool Erase(Entity entity, uint32_t& removed) {
+        int index = IndexOf(entity);
+        if (index < 0) {
+            return false;
+        }
+        Entity moved = dense.back();
+        dense[index] = moved;
+        sparse[HandleSlot(moved)] = static_cast<uint32_t>(index);
+        sparse[HandleSlot(entity)] = NONE;
+        dense.pop_back();
+        version++;
+        removed = static_cast<uint32_t>(index);
+        return true;
+    }
+
+    void ClearSet() {
+        for (Entity entity : dense) {
+            sparse[HandleSlot(entity)] = NONE;
+        }
+        dense.clear();
+        version++;
+    }
+
+private:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    std::vector<uint32_t> sparse;
+    std::vector<Entity> dense;
+    uint64_t version = 0;
+};
+
+// Typed component pool, components are packed in the same order as Entities()
+template<typename T>
+class ComponentPool : public SparseSet {
+public:
+    T& Add(Entity entity, const T& value) {
+        int index = IndexOf(entity);
+        if (index >= 0) {
+            components[index] = value;
+            return components[index];
+        }
+        Emplace(entity);
+        components.push_back(value);
+        return components.back();
+    }
+
+    T* Get(Entity entity) {
+        int index = IndexOf(entity);
+        return index >= 0 ? &components[index] : nullptr;
+    }
+
+    bool Remove(Entity entity) override {
+        uint32_t removed;
+        if (!Erase(entity, removed)) {
+            return false;
+        }
+        if (removed != components.size() - 1) {
+            components[removed] = std::move(components.back());
+        }
+        components.pop_back();
+        return true;
+    }
+
+    void Clear() override {
+        ClearSet();
+        components.clear();
+    }
+
+    T& At(size_t dense) { return components[dense]; }
+    T* Data() { return components.data(); }
+
+private:
+    std::vector<T> components;
+};
+
+inline size_t NextComponentTypeId() {
+    static size_t next = 0;
+    return next++;
+}
+
+template<typename T>
+size_t ComponentTypeId() {
+    static const size_t id = NextComponentTypeId();
+    return id;
+}
+
+// Registry of typed component pools with cached multi-component views
+class Registry {
+public:
+    template<typename T>
+    ComponentPool<T>& Pool() {
+        size_t id = ComponentTypeId<T>();
+        if (id >= pools.size()) {
+            pools.resize(id + 1);
+        }
+        if (!pools[id]) {
+            pools[id] = std::make_unique<ComponentPool<T>>();
+        }
+        return static_cast<ComponentPool<T>&>(*pools[id]);
+    }
+
+    template<typename T>
+    T& Add(Entity entity, const T& value) { return Pool<T>().Add(entity, value); }
+
+    template<typename T>
+    T* Get(Entity entity) { return Pool<T>().Get(entity); }
+
+    template<typename T>
+    bool Has(Entity entity) { return Pool<T>().Contains(entity); }
+
+    template<typename T>
+    bool Remove(Entity entity) { return Pool<T>().Remove(entity); }
+
+    // Drop every component of the entity
+    void DestroyEntity(Entity entity) {
+        for (auto& pool : pools) {
+            if (pool) {
+                pool->Remove(entity);
+            }
+        }
+    }
+
+    void Clear() {
+        for (auto& pool : pools) {
+            if (pool) {
+                pool->Clear();
+            }
+        }
+    }
+
+    // Call fn(entity, T&...) for every entity that has all the components.
+    // A single component streams its packed array directly; multi-component
+    // views reuse a cached match list until one of the pools changes membership.
+    // fn must not add or remove components of the iterated types.
+    template<typename... Ts, typename F>
+    void Each(F&& fn) {
+        if constexpr (sizeof...(Ts) == 1) {
+            EachSingle<Ts...>(fn);
+        } else {
+            EachCached<Ts...>(fn, std::index_sequence_for<Ts...>{});
+        }
+    }
+
+private:
+    struct CachedViewBase {
+        virtual ~CachedViewBase() = default;
+    };
+
+    template<typename... Ts>
+    struct CachedView : CachedViewBase {
+        std::vector<Entity> entities;
+        std::vector<std::array<uint32_t, sizeof...(Ts)>> indices;   // dense index into each pool
+        std::array<uint64_t, sizeof...(Ts)> versions{};
+        bool built = false;
+    };
+
+    static size_t NextViewTypeId() {
+        static size_t next = 0;
+        return next++;
+    }
+
+    template<typename... Ts>
+    static size_t ViewTypeId() {
+        static const size_t id = NextViewTypeId();
+        return id;
+    }
+
+    template<typename T, typename F>
+    void EachSingle(F& fn) {
+        ComponentPool<T>& pool = Pool<T>();
+        const std::vector<Entity>& entities = pool.Entities();
+        T* data = pool.Data();
+        for (size_t i = 0; i < entities.size(); i++) {
+            fn(entities[i], data[i]);
+        }
+    }
+
+    template<typename... Ts, typename F, size_t... I>
+    void EachCached(F& fn, std::index_sequence<I...>) {
+        std::array<SparseSet*, sizeof...(Ts)> sets = {&Pool<Ts>()...};
+        CachedView<Ts...>& view = GetView<Ts...>();
+
+        std::array<uint64_t, sizeof...(Ts)> versions = {sets[I]->Version()...};
+        if (!view.built || versions != view.versions) {
+            RebuildView(view, sets);
+            view.versions = versions;
+            view.built = true;
+        }
+
+        std::array<void*, sizeof...(Ts)> data = {static_cast<void*>(Pool<Ts>().Data())...};
+        for (size_t n = 0; n < view.entities.size(); n++) {
+            const auto& index = view.indices[n];
+            fn(view.entities[n], static_cast<Ts*>(data[I])[index[I]]...);
+        }
+    }
+
+    template<typename... Ts>
+    CachedView<Ts...>& GetView() {
+        size_t id = ViewTypeId<Ts...>();
+        if (id >= views.size()) {
+            views.resize(id + 1);
+        }
+        if (!views[id]) {
+            views[id] = std::make_unique<CachedView<Ts...>>();
+        }
+        return static_cast<CachedView<Ts...>&>(*views[id]);
+    }
+
+    // Walk the smallest pool and keep entities present in all of them
+    template<typename View, size_t N>
+    static void RebuildView(View& view, const std::array<SparseSet*, N>& sets) {
+        size_t smallest = 0;
+        for (size_t s = 1; s < N; s++) {
+            if (sets[s]->Size() < sets[smallest]->Size()) {
+                smallest = s;
+            }
+        }
+
+        view.entities.clear();
+        view.indices.clear();
+        for (Entity entity : sets[smallest]->Entities()) {
+            std::array<uint32_t, N> index;
+            bool match = true;
+            for (size_t s = 0; s < N && match; s++) {
+                int dense = sets[s]->IndexOf(entity);
+                match = dense >= 0;
+                index[s] = static_cast<uint32_t>(dense);
+            }
+            if (match) {
+                view.entities.push_back(entity);
+                view.indices.push_back(index);
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<SparseSet>> pools;
+    std::vector<std::unique_ptr<CachedViewBase>> views;
+};
+
+#endif //QENGINE_ECS_H
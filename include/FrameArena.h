@@ -0,0 +1,102 @@
+#ifndef QENGINE_FRAMEARENA_H
+#define QENGINE_FRAMEARENA_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Per-frame bump allocator for transient buffers. Everything allocated from it is
+// released at once by Reset(). If a frame outgrows the block, the overflow goes to
+// extra blocks and the next Reset() merges them into one block big enough for the
+// peak, so steady-state frames never touch the heap.
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity = 256 * 1024);
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Resize the most recent allocation in place when possible, otherwise copy to a new one
+    void* Reallocate(void* pointer, size_t oldSize, size_t newSize, size_t alignment = alignof(std::max_align_t));
+
+    template<typename T>
+    T* AllocateArray(size_t count) {
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Release everything allocated since the last reset
+    void Reset();
+
+    size_t Used() const { return used + overflowUsed; }
+    size_t Capacity() const { return capacity; }
+    size_t HighWater() const { return highWater; }
+
+private:
+    std::unique_ptr<unsigned char[]> block;
+    size_t capacity;
+    size_t used;
+    size_t highWater;
+
+    // Blocks allocated after the main block ran out this frame
+    std::vector<std::unique_ptr<unsigned char[]>> overflow;
+    size_t overflowUsed;
+    size_t overflowOffset;
+    size_t overflowCapacity;
+
+    // Last allocation, the only one that can grow in place
+    unsigned char* top;
+};
+
+// Growable array living in a frame arena, trivially copyable element types only.
+// Memory is reclaimed by the arena's Reset(), never by the vector itself.
+template<typename T>
+class ArenaVector {
+public:
+    explicit ArenaVector(FrameArena& arena, size_t reserve = 16)
+        : arena(&arena), items(nullptr), count(0), capacity(0) {
+        Reserve(reserve);
+    }
+
+    void push_back(const T& value) {
+        if (count == capacity) {
+            Reserve(capacity ? capacity * 2 : 16);
+        }
+        items[count++] = value;
+    }
+
+    void Reserve(size_t newCapacity) {
+        if (newCapacity <= capacity) {
+            return;
+        }
+        items = static_cast<T*>(arena->Reallocate(items, capacity * sizeof(T), newCapacity * sizeof(T), alignof(T)));
+        capacity = newCapacity;
+    }
+
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T* data() { return items; }
+    const T* data() const { return items; }
+    T& operator[](size_t i) { return items[i]; }
+    const T& operator[](size_t i) const { return items[i]; }
+    T* begin() { return items; }
+    T* end() { return items + count; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+
+    std::span<T> Span() { return {items, count}; }
+
+private:
+    FrameArena* arena;
+    T* items;
+    size_t count;
+    size_t capacity;
+};
+
+// Arena for the simulation frame, reset at the start of every frame
+extern FrameArena frameArena;
+
+#endif //QENGINE_FRAMEARENA_H
@@ -0,0 +1,63 @@
+#ifndef QENGINE_FRAMEPIPELINE_H
+#define QENGINE_FRAMEPIPELINE_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "Sprite.h"
+
+struct GLFWwindow;
+
+// Everything the renderer needs for one frame, written by the simulation and read-only afterwards
+struct RenderSnapshot {
+    std::vector<Sprite> sprites;
+};
+
+// Two-stage frame pipeline: the simulation of frame N+1 runs on a worker thread
+// while the main thread submits frame N to the GPU.
+class FramePipeline {
+public:
+    using SimulateFn = std::function<void(float deltaTime, RenderSnapshot& out)>;
+
+    FramePipeline();
+    ~FramePipeline();
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    // threaded = false runs the simulation inline in Kick(). loaderContext is a hidden window
+    // sharing objects with the main context, made current on the worker so scripts can load textures.
+    void Start(SimulateFn simulate, bool threaded, GLFWwindow* loaderContext = nullptr);
+    void Stop();
+
+    // Begin simulating the next frame
+    void Kick(float deltaTime);
+
+    // Block until the frame started by Kick() is finished and publish its snapshot.
+    // Between Wait() and the next Kick() the simulation is idle and engine state may be touched.
+    void Wait();
+
+    // Latest published snapshot, safe to render while the next frame simulates
+    const RenderSnapshot& Current() const { return snapshots[front]; }
+
+    bool IsThreaded() const { return worker.joinable(); }
+
+private:
+    void WorkerLoop(GLFWwindow* loaderContext);
+
+    SimulateFn simulate;
+    RenderSnapshot snapshots[2];
+    int front;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable kicked;
+    std::condition_variable finished;
+    bool pending;   // frame kicked but not yet simulated
+    bool ready;     // frame simulated but not yet published
+    bool quit;
+    float frameDelta;
+};
+
+#endif //QENGINE_FRAMEPIPELINE_H
@@ -0,0 +1,69 @@
+#ifndef QENGINE_GPUPROFILER_H
+#define QENGINE_GPUPROFILER_H
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <vector>
+
+// Last and running average GPU time of one render pass
+struct GpuPassTiming {
+    const char* name;
+    float milliseconds;
+    float average;
+    uint64_t samples;
+};
+
+// GPU time per render pass from GL_TIME_ELAPSED queries. Queries rotate through a
+// pool several frames deep and results are only read once available, so timing
+// never stalls the pipeline; numbers trail the current frame by a few frames.
+// Passes must not nest.
+//
+// Results also go to the CPU profiler's "GPU" track, placed at the pass's CPU
+// submit time with the GPU duration.
+class GpuProfiler {
+public:
+    static const int MAX_PASSES = 8;
+    static const int QUERY_FRAMES = 4;
+
+    // Needs a current GL context
+    static void Initialize();
+    static void Shutdown();
+
+    // Bracket a frame's passes, BeginFrame also collects results that are ready
+    static void BeginFrame();
+    static void EndFrame();
+
+    static void BeginPass(const char* name);
+    static void EndPass();
+
+    static const std::vector<GpuPassTiming>& Timings() { return timings; }
+
+private:
+    struct PassQuery {
+        const char* name;
+        GLuint query;
+        uint64_t cpuStart;
+        bool pending;
+    };
+
+    static PassQuery queries[QUERY_FRAMES][MAX_PASSES];
+    static int passCount[QUERY_FRAMES];
+    static uint64_t frameIndex;
+    static bool passOpen;
+    static bool initialized;
+    static std::vector<GpuPassTiming> timings;
+
+    static void Collect(int frame);
+    static void Store(const char* name, float milliseconds);
+};
+
+// Scoped pass for GpuProfiler
+class GpuPassScope {
+public:
+    explicit GpuPassScope(const char* name) { GpuProfiler::BeginPass(name); }
+    ~GpuPassScope() { GpuProfiler::EndPass(); }
+    GpuPassScope(const GpuPassScope&) = delete;
+    GpuPassScope& operator=(const GpuPassScope&) = delete;
+};
+
+#endif //QENGINE_GPUPROFILER_H
@@ -0,0 +1,87 @@
+#ifndef QENGINE_INPUT_H
+#define QENGINE_INPUT_H
+
+#include <bitset>
+#include <cstdint>
+#include <GLFW/glfw3.h>
+
+enum InputEventType : uint8_t {
+    INPUT_KEY,
+    INPUT_MOUSE_BUTTON,
+    INPUT_CURSOR,
+    INPUT_FOCUS_LOST
+};
+
+// One raw input change, what the GLFW callbacks deliver and what recordings store
+struct InputEvent {
+    InputEventType type;
+    uint8_t action;      // GLFW_PRESS / GLFW_RELEASE
+    uint16_t code;       // key or mouse button
+    double x, y;         // cursor position for INPUT_CURSOR
+};
+
+// Input manager - all static methods. GLFW callbacks write key and mouse state into
+// fixed-size bitsets, so every query is a single bit test.
+//
+// Callbacks and replays only touch the live state, on the main thread. BeginFrame,
+// called on the main thread before the simulation is kicked, copies it into the
+// frame state that every query reads, so a simulation running on the pipeline
+// thread never sees input change under it.
+//
+// Pressed/released edges are latched until a simulation tick has seen them
+// (EndTick), so a tap is never lost on a frame that runs no ticks and never
+// reported twice on a frame that runs several.
+class InputManager {
+public:
+    // Install the callbacks, call before ImGui so its backend chains to them
+    static void Install(GLFWwindow* window);
+
+    // Held this tick
+    static bool IsKeyDown(int key);
+    static bool IsMouseButtonDown(int button);
+
+    // Went down / up since the previous tick
+    static bool WasKeyPressed(int key);
+    static bool WasKeyReleased(int key);
+    static bool WasMouseButtonPressed(int button);
+    static bool WasMouseButtonReleased(int button);
+
+    static void GetMousePosition(double& x, double& y) { x = frame.mouseX; y = frame.mouseY; }
+
+    // Publish the live state to the simulation, call while it is idle
+    static void BeginFrame();
+
+    // Clear the edges once the simulation has consumed them
+    static void EndTick();
+
+    // Drop all state, e.g. when the window loses focus and releases would be missed
+    static void Clear();
+
+    // Update state from an event. Live callbacks and replays both go through here.
+    static void Apply(const InputEvent& event);
+
+private:
+    static const int KEY_COUNT = GLFW_KEY_LAST + 1;
+    static const int MOUSE_BUTTON_COUNT = GLFW_MOUSE_BUTTON_LAST + 1;
+
+    struct InputState {
+        std::bitset<KEY_COUNT> keysDown;
+        std::bitset<KEY_COUNT> keysPressed;
+        std::bitset<KEY_COUNT> keysReleased;
+        std::bitset<MOUSE_BUTTON_COUNT> buttonsDown;
+        std::bitset<MOUSE_BUTTON_COUNT> buttonsPressed;
+        std::bitset<MOUSE_BUTTON_COUNT> buttonsReleased;
+        double mouseX = 0.0;
+        double mouseY = 0.0;
+    };
+
+    static InputState live;
+    static InputState frame;
+
+    static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+    static void CursorPosCallback(GLFWwindow* window, double x, double y);
+    static void FocusCallback(GLFWwindow* window, int focused);
+};
+
+#endif //QENGINE_INPUT_H
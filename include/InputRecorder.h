@@ -0,0 +1,49 @@
+#ifndef QENGINE_INPUTRECORDER_H
+#define QENGINE_INPUTRECORDER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Input.h"
+
+// Records every frame's input events and delta time to a binary log and plays it
+// back. The log also stores the random seed handed to Lua and a checksum of the
+// sprite store after each frame, so a replay can prove it stayed bit-for-bit in sync.
+//
+// Layout: "QREC", uint32 version, uint32 seed, then per frame
+//   float dt, uint32 event count, events (uint8 type, uint8 action, uint16 code,
+//   plus two doubles for cursor events), uint64 checksum
+class InputRecorder {
+public:
+    static bool StartRecording(const std::string& path, uint32_t seed);
+    static bool StartReplay(const std::string& path);
+    static void Stop();
+
+    static bool IsRecording() { return mode == Mode::Recording; }
+    static bool IsReplaying() { return mode == Mode::Replaying; }
+    static uint32_t GetSeed() { return seed; }
+
+    // Recording: queue a live event for the current frame
+    static void RecordEvent(const InputEvent& event);
+
+    // Start of a frame. Recording writes dt and the queued events. Replaying
+    // replaces dt and applies the logged events, returns false once the log ends.
+    static bool BeginFrame(float& deltaTime);
+
+    // After the frame's simulation. Recording writes the checksum, replaying compares it.
+    static void EndFrame(uint64_t checksum);
+
+    static uint64_t FrameCount() { return frames; }
+    static uint64_t MismatchCount() { return mismatches; }
+
+private:
+    enum class Mode { Off, Recording, Replaying };
+
+    static Mode mode;
+    static uint32_t seed;
+    static std::vector<InputEvent> pending;
+    static uint64_t frames;
+    static uint64_t mismatches;
+};
+
+#endif //QENGINE_INPUTRECORDER_H
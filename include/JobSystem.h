@@ -0,0 +1,81 @@
+#ifndef QENGINE_JOBSYSTEM_H
+#define QENGINE_JOBSYSTEM_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+// A unit of work. The callable is stored inline, so submitting a job never allocates.
+struct Job {
+    void (*function)(Job&);
+    Job* parent;
+    std::atomic<int> unfinished;   // this job plus its unfinished children
+    alignas(16) unsigned char data[48];
+};
+
+// Work-stealing job system - all static methods, shared by every engine subsystem.
+// Each thread owns a deque: it pushes and pops its own work from the back while
+// idle workers steal from the front of other threads' deques.
+class JobSystem {
+public:
+    // workerCount = 0 picks hardware_concurrency - 1
+    static void Initialize(unsigned workerCount = 0);
+    static void Shutdown();
+    static unsigned WorkerCount();
+    static bool IsRunning();
+
+    // Create a job from a small trivially-copyable callable (lambda capturing pointers/values).
+    // Passing a parent makes the parent count as unfinished until this child completes.
+    template<typename F>
+    static Job* CreateJob(const F& function, Job* parent = nullptr) {
+        static_assert(sizeof(F) <= sizeof(Job::data), "Job callable too large, capture a pointer instead");
+        static_assert(std::is_trivially_copyable_v<F>, "Job callable must be trivially copyable");
+
+        Job* job = AllocateJob(parent);
+        new (job->data) F(function);
+        job->function = [](Job& self) {
+            (*std::launder(reinterpret_cast<F*>(self.data)))();
+        };
+        return job;
+    }
+
+    // Queue a job on the calling thread's deque
+    static void Run(Job* job);
+
+    // Block until the job and all its children finished, executing other jobs meanwhile
+    static void Wait(const Job* job);
+
+    static bool IsFinished(const Job* job) {
+        return job->unfinished.load(std::memory_order_acquire) == 0;
+    }
+
+    // Split [0, count) into chunks of at least 'grain' items and run fn(begin, end) on each in parallel
+    template<typename F>
+    static void ParallelFor(size_t count, size_t grain, const F& fn) {
+        if (count == 0) {
+            return;
+        }
+        if (!IsRunning() || count <= grain) {
+            fn(size_t(0), count);
+            return;
+        }
+
+        size_t chunk = ChunkSize(count, grain);
+        const F* body = &fn;
+
+        Job* root = CreateJob([] {});
+        for (size_t begin = 0; begin < count; begin += chunk) {
+            size_t end = begin + chunk < count ? begin + chunk : count;
+            Run(CreateJob([body, begin, end] { (*body)(begin, end); }, root));
+        }
+        Run(root);
+        Wait(root);
+    }
+
+private:
+    static Job* AllocateJob(Job* parent);
+    static size_t ChunkSize(size_t count, size_t grain);
+};
+
+#endif //QENGINE_JOBSYSTEM_H
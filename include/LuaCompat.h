@@ -0,0 +1,55 @@
+#ifndef QENGINE_LUACOMPAT_H
+#define QENGINE_LUACOMPAT_H
+
+// Include after the Lua headers. The engine is written against the Lua 5.4 API;
+// with USE_LUAJIT this fills in the pieces LuaJIT's 5.1 API lacks.
+
+#if USE_LUAJIT
+extern "C" {
+#include <luajit.h>
+}
+
+#ifndef LUA_OK
+#define LUA_OK 0
+#endif
+
+#define lua_rawlen(L, i) lua_objlen(L, (i))
+
+// 5.4 style resume. LuaJIT has no 'from' thread, and after a yield or return
+// the coroutine's stack holds exactly the transferred values.
+inline int LuaResume(lua_State* co, lua_State* from, int nargs, int* nresults) {
+    (void)from;
+    int status = lua_resume(co, nargs);
+    *nresults = lua_gettop(co);
+    return status;
+}
+
+// LuaJIT numbers are all doubles, integral ones in range convert exactly
+inline bool LuaToInteger(lua_State* L, int idx, lua_Integer* out) {
+    if (lua_type(L, idx) != LUA_TNUMBER) {
+        return false;
+    }
+    lua_Number n = lua_tonumber(L, idx);
+    if (!(n >= -0x1p63 && n < 0x1p63) || (lua_Number)(lua_Integer)n != n) {
+        return false;
+    }
+    *out = (lua_Integer)n;
+    return true;
+}
+#else
+inline int LuaResume(lua_State* co, lua_State* from, int nargs, int* nresults) {
+    return lua_resume(co, from, nargs, nresults);
+}
+
+// Integer value of a number argument, false for non-numbers and floats with a fractional part
+inline bool LuaToInteger(lua_State* L, int idx, lua_Integer* out) {
+    if (lua_type(L, idx) != LUA_TNUMBER) {
+        return false;
+    }
+    int isnum = 0;
+    *out = lua_tointegerx(L, idx, &isnum);
+    return isnum != 0;
+}
+#endif
+
+#endif //QENGINE_LUACOMPAT_H
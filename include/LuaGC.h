@@ -0,0 +1,45 @@
+#ifndef QENGINE_LUAGC_H
+#define QENGINE_LUAGC_H
+
+#include <cstdint>
+
+struct lua_State;
+
+enum class LuaGCMode {
+    Incremental,
+    Generational    // Lua 5.4 only, LuaJIT builds fall back to incremental
+};
+
+// Lua collector tuning plus frame-budgeted collection - all static methods.
+// Step() is called where the VM is otherwise idle and spends at most the budget
+// paying off GC debt, so the collector has less work left to do inside Update.
+// Stats follow the PerformanceStats rule: read them only while the simulation is idle.
+class LuaGC {
+public:
+    static void Configure(lua_State* L, LuaGCMode mode);
+    static LuaGCMode Mode() { return mode; }
+
+    // Idle time per frame given to the collector, 0 leaves it fully automatic
+    static void SetStepBudget(int microseconds);
+    static int StepBudget() { return budgetMicroseconds; }
+
+    static void Step(lua_State* L);
+
+    static double HeapKilobytes() { return heapKilobytes; }
+    static double LastIdleMicroseconds() { return lastIdleMicroseconds; }
+    static int LastStepCount() { return lastSteps; }
+    static double PeakStepMicroseconds() { return peakStepMicroseconds; }   // longest single step since ResetPeak
+    static uint64_t Cycles() { return cycles; }                             // cycles finished in idle time
+    static void ResetPeak() { peakStepMicroseconds = 0.0; }
+
+private:
+    static LuaGCMode mode;
+    static int budgetMicroseconds;
+    static double heapKilobytes;
+    static double lastIdleMicroseconds;
+    static int lastSteps;
+    static double peakStepMicroseconds;
+    static uint64_t cycles;
+};
+
+#endif //QENGINE_LUAGC_H
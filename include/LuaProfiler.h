@@ -0,0 +1,49 @@
+#ifndef QENGINE_LUAPROFILER_H
+#define QENGINE_LUAPROFILER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct lua_State;
+
+enum class LuaSampleMode {
+    Instructions,   // one sample every 'interval' VM instructions
+    Time            // one sample every 'interval' microseconds of Lua execution
+};
+
+struct LuaBindingStats {
+    const char* name;
+    uint64_t calls;
+    uint64_t nanoseconds;
+};
+
+// Sampling profiler for scripts - all static methods. A count hook captures the Lua
+// call stack into collapsed stacks ("outer;inner count" lines, the input format of
+// flamegraph.pl and speedscope). While running, the registered C bindings are swapped
+// for timing wrappers, so time spent in the engine is counted per binding instead.
+// Coroutines created after Start inherit the hook, CoroutineScheduler copies it onto
+// the ones it resumes that were created before. Under LuaJIT, compiled traces do
+// not run hooks, so only interpreted code shows up in the samples.
+// Start, Stop and the results must only be touched while the simulation is idle.
+class LuaProfiler {
+public:
+    // Called by RegisterBinding so the bindings can be wrapped later
+    static void AddBinding(const char* name);
+
+    static void Start(lua_State* L, LuaSampleMode mode, int interval);
+    static void Stop(lua_State* L);
+    static bool IsRunning() { return running; }
+
+    static void Clear();
+    static uint64_t SampleCount();
+    static const std::vector<LuaBindingStats>& Bindings();
+
+    // One line per distinct Lua stack with its sample count
+    static bool WriteCollapsedStacks(const std::string& path);
+
+private:
+    static bool running;
+};
+
+#endif //QENGINE_LUAPROFILER_H
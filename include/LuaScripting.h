@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <GLFW/glfw3.h>
+#include "SlotMap.h"
 
 // Forward declare lua_State
 struct lua_State;
@@ -12,5 +13,9 @@ void shutdownLua();
 void registerLuaFunctions();
 void SetLuaWindow(GLFWwindow* window);
 
+// Destroy a sprite the way DestroySprite does: texture, tweens and script included.
+// L runs the script's OnDestroy.
+bool DestroyScriptSprite(lua_State* L, SlotHandle handle);
+
 // Lua functions exposed to C++ (optional)
 bool RunLuaFile(const std::string& filepath);
@@ -0,0 +1,24 @@
+#ifndef QENGINE_LUASPRITEPROXY_H
+#define QENGINE_LUASPRITEPROXY_H
+
+#include "SlotMap.h"
+
+struct lua_State;
+
+// Sprite proxies: small full userdata holding a sprite handle, whose __index and
+// __newindex read and write the world's SpriteStore directly, so scripts can write
+// s.x = s.x + 1. Fields: x, y, width, height, r, g, b, a, texture, handle (read-only)
+// and valid (read-only). Reads of a destroyed sprite give nil and writes are ignored.
+
+// Create the proxy metatable in this VM
+void RegisterSpriteProxy(lua_State* L);
+
+void PushSpriteProxy(lua_State* L, SlotHandle handle);
+
+// Sprite argument as an integer handle or a proxy, INVALID_HANDLE for anything else
+SlotHandle ToSpriteHandle(lua_State* L, int arg);
+
+// Same, but raises a Lua argument error for anything else
+SlotHandle CheckSpriteHandle(lua_State* L, int arg);
+
+#endif //QENGINE_LUASPRITEPROXY_H
@@ -0,0 +1,40 @@
+#ifndef QENGINE_OFFSCREENCONTEXT_H
+#define QENGINE_OFFSCREENCONTEXT_H
+
+#include <GL/glew.h>
+#include <string>
+
+// GL context with no window or display: an EGL surfaceless context (Mesa llvmpipe
+// works) rendering into a framebuffer object. Lets the renderer run on build
+// machines and dump frames for golden-image checks. Needs OFFSCREEN_RENDERING.
+class OffscreenContext {
+public:
+    OffscreenContext() = default;
+    ~OffscreenContext() { Destroy(); }
+    OffscreenContext(const OffscreenContext&) = delete;
+    OffscreenContext& operator=(const OffscreenContext&) = delete;
+
+    // Create the context, make it current and bind a width x height color target
+    bool Create(int width, int height);
+    void Destroy();
+
+    // Bind the framebuffer and viewport for drawing
+    void Bind() const;
+
+    // Read the color target back and write it as an 8-bit RGBA PNG
+    bool SavePNG(const std::string& path) const;
+
+    GLuint ColorTexture() const { return colorTexture; }
+    int Width() const { return width; }
+    int Height() const { return height; }
+
+private:
+    void* display = nullptr;
+    void* context = nullptr;
+    GLuint framebuffer = 0;
+    GLuint colorTexture = 0;
+    int width = 0;
+    int height = 0;
+};
+
+#endif //QENGINE_OFFSCREENCONTEXT_H
@@ -0,0 +1,47 @@
+#ifndef QENGINE_PERFORMANCESTATS_H
+#define QENGINE_PERFORMANCESTATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Always-on runtime counters for the Performance window. Render counters are
+// bumped on the render thread, Lua time on the simulation thread and published
+// when its frame ends; read them only while the simulation is idle.
+class PerformanceStats {
+public:
+    static const int HISTORY = 240;
+
+    // Main loop, once per presented frame
+    static void RecordFrameTime(float milliseconds);
+    static void BeginRender();
+
+    static void CountDrawCall() { drawCalls++; }
+    static void CountTextureBind() { textureBinds++; }
+
+    // Simulation thread
+    static void AddLuaTime(double milliseconds) { luaPending += milliseconds; }
+    static void EndSimulationFrame();
+
+    static const float* FrameTimes() { return frameTimes; }
+    static int FrameTimeOffset() { return frameTimeNext; }
+    // Over the recorded frames, fewer than HISTORY until the buffer first fills
+    static float AverageFrameTime();
+    static float LastFrameTime() { return frameTimes[(frameTimeNext + HISTORY - 1) % HISTORY]; }
+
+    static uint32_t DrawCalls() { return lastDrawCalls; }
+    static uint32_t TextureBinds() { return lastTextureBinds; }
+    static double LuaMilliseconds() { return luaMilliseconds; }
+
+private:
+    static float frameTimes[HISTORY];
+    static int frameTimeNext;
+    static int frameTimeCount;
+    static uint32_t drawCalls;
+    static uint32_t textureBinds;
+    static uint32_t lastDrawCalls;
+    static uint32_t lastTextureBinds;
+    static double luaPending;
+    static double luaMilliseconds;
+};
+
+#endif //QENGINE_PERFORMANCESTATS_H
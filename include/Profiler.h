@@ -0,0 +1,61 @@
+#ifndef QENGINE_PROFILER_H
+#define QENGINE_PROFILER_H
+
+#include <cstdint>
+#include <string>
+
+// Scoped CPU profiler. Each thread records begin/end timestamps into its own ring
+// buffer with no locking; WriteChromeTrace() dumps every buffer as a Chrome trace
+// (load it in chrome://tracing or ui.perfetto.dev). With ENABLE_PROFILER=0 the
+// macros expand to nothing.
+//
+// Names must outlive the profiler (string literals, __func__).
+#if ENABLE_PROFILER
+#define QE_PROFILE_CONCAT_INNER(a, b) a##b
+#define QE_PROFILE_CONCAT(a, b) QE_PROFILE_CONCAT_INNER(a, b)
+#define QE_PROFILE_SCOPE(name) ProfileScope QE_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define QE_PROFILE_FUNCTION() QE_PROFILE_SCOPE(__func__)
+#define QE_PROFILE_THREAD(name) Profiler::SetThreadName(name)
+#else
+#define QE_PROFILE_SCOPE(name) ((void)0)
+#define QE_PROFILE_FUNCTION() ((void)0)
+#define QE_PROFILE_THREAD(name) ((void)0)
+#endif
+
+class Profiler {
+public:
+    // Events kept per thread, older ones are overwritten
+    static const size_t EVENTS_PER_THREAD = 1 << 16;
+
+    // Nanoseconds on a monotonic clock
+    static uint64_t Now();
+
+    static void Record(const char* name, uint64_t start, uint64_t end);
+
+    // Record onto the separate "GPU" track, from the thread that owns the GL context
+    static void RecordGpu(const char* name, uint64_t start, uint64_t end);
+    static void SetThreadName(const char* name);
+
+    // Write everything recorded so far. Call while the simulation is idle, events
+    // being written by other threads at that moment may be dropped.
+    static bool WriteChromeTrace(const std::string& path);
+
+    // Forget all recorded events
+    static void Clear();
+
+    static bool Enabled() { return ENABLE_PROFILER != 0; }
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name), start(Profiler::Now()) {}
+    ~ProfileScope() { Profiler::Record(name, start, Profiler::Now()); }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#endif //QENGINE_PROFILER_H
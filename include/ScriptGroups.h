@@ -0,0 +1,39 @@
+#ifndef QENGINE_SCRIPTGROUPS_H
+#define QENGINE_SCRIPTGROUPS_H
+
+#include <cstddef>
+#include <string>
+#include <variant>
+
+struct lua_State;
+
+// Message payload: nil, boolean, number or string
+using ScriptValue = std::variant<std::monostate, bool, double, std::string>;
+
+// Message argument as a ScriptValue, raises a Lua argument error for other types
+ScriptValue CheckScriptValue(lua_State* L, int arg);
+
+// Independent script groups, each in its own lua_State - all static methods.
+// Once per tick, after the main VM, every group's global Update(dt) runs in parallel
+// on the job system. The world is read-only while they run: group scripts query
+// sprites directly, but their changes are queued as commands and applied at the sync
+// point after all groups finish, in group start order, so the result does not depend
+// on scheduling. VMs talk through PostMessage(to, channel, value), "main" being the
+// main VM. The receiver's global OnMessage(from, channel, value) gets it - the main VM
+// at the sync point, a group at the start of its next Update.
+class ScriptGroupManager {
+public:
+    // Create a group VM and run its script, replaces a running group of the same name
+    static bool Start(const std::string& name, const std::string& scriptPath);
+    static bool Stop(const std::string& name);
+    static void StopAll();
+
+    // From the main VM, delivered to the group's next Update
+    static bool Post(const std::string& to, const std::string& channel, ScriptValue value);
+
+    static void Update(lua_State* mainState, float deltaTime);
+
+    static size_t Count();
+};
+
+#endif //QENGINE_SCRIPTGROUPS_H
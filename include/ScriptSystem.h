@@ -0,0 +1,30 @@
+#ifndef QENGINE_SCRIPTSYSTEM_H
+#define QENGINE_SCRIPTSYSTEM_H
+
+#include "World.h"
+
+struct lua_State;
+
+// Per-entity Lua scripts - all static methods. Attaching a script class makes an
+// instance table inheriting from it and resolves the callbacks once into registry
+// references, so dispatching one is a lua_rawgeti and a call:
+//   OnStart(self)  OnUpdate(self, dt)  OnCollision(self, other)  OnDestroy(self)
+// self.sprite is the entity's sprite proxy, self.handle its handle and 'other' a handle.
+// Callbacks added to the class after attaching are not picked up. Entities removed
+// without Detach (World::Clear) keep their references until the VM is closed.
+class ScriptSystem {
+public:
+    // Attach the script class at stack index 'classIndex', replacing any script the
+    // entity had, then run OnStart. Pushes the instance table.
+    static void Attach(lua_State* L, World& world, Entity entity, int classIndex);
+
+    // Run OnDestroy and release the instance, call before destroying a scripted entity
+    static bool Detach(lua_State* L, World& world, Entity entity);
+
+    static void Update(lua_State* L, World& world, float deltaTime);
+
+    // OnCollision on both sides of every contact CollisionSystem found this tick
+    static void DispatchCollisions(lua_State* L, World& world);
+};
+
+#endif //QENGINE_SCRIPTSYSTEM_H
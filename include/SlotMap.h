@@ -0,0 +1,178 @@
+#ifndef QENGINE_SLOTMAP_H
+#define QENGINE_SLOTMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Stable handle: low 32 bits are the slot, high 32 bits the slot's generation.
+// Generations start at 0, so the first objects ever created get handles 0, 1, 2...
+using SlotHandle = uint64_t;
+constexpr SlotHandle INVALID_HANDLE = ~SlotHandle(0);
+
+inline uint32_t HandleSlot(SlotHandle handle) { return static_cast<uint32_t>(handle); }
+inline uint32_t HandleGeneration(SlotHandle handle) { return static_cast<uint32_t>(handle >> 32); }
+inline SlotHandle MakeHandle(uint32_t slot, uint32_t generation) {
+    return (static_cast<SlotHandle>(generation) << 32) | slot;
+}
+
+// LuaJIT has no integer type, handles reach scripts as doubles that are exact up to 2^53,
+// leaving 21 bits of generation above the slot
+#if defined(USE_LUAJIT) && USE_LUAJIT
+constexpr uint32_t MAX_GENERATION = (1u << 21) - 1;
+#else
+constexpr uint32_t MAX_GENERATION = 0xFFFFFFFFu;
+#endif
+
+// Handle bookkeeping for a dense array: maps generation-checked handles to dense
+// indices and back. Owners keep their data in dense order and mirror the
+// swap-remove reported by Remove(), so creation and deletion are O(1).
+class SlotIndex {
+public:
+    // Allocate a handle for a new element appended at dense index Size()
+    SlotHandle Create() {
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.push_back({0, 0});
+        }
+        slots[slot].dense = static_cast<uint32_t>(denseToSlot.size());
+        denseToSlot.push_back(slot);
+        return MakeHandle(slot, slots[slot].generation);
+    }
+
+    // Dense index of a live handle, or -1 if the handle is stale or invalid
+    int Find(SlotHandle handle) const {
+        uint32_t slot = HandleSlot(handle);
+        if (slot >= slots.size() || slots[slot].generation != HandleGeneration(handle) ||
+            slots[slot].dense == NONE) {
+            return -1;
+        }
+        return static_cast<int>(slots[slot].dense);
+    }
+
+    bool Contains(SlotHandle handle) const { return Find(handle) >= 0; }
+
+    // Release a handle. On success 'removed' is the dense index that was freed and
+    // the caller must move its last element into it (swap-remove) and pop the back.
+    bool Remove(SlotHandle handle, uint32_t& removed) {
+        int dense = Find(handle);
+        if (dense < 0) {
+            return false;
+        }
+
+        uint32_t slot = HandleSlot(handle);
+        uint32_t last = static_cast<uint32_t>(denseToSlot.size() - 1);
+        uint32_t movedSlot = denseToSlot[last];
+        denseToSlot[dense] = movedSlot;
+        slots[movedSlot].dense = static_cast<uint32_t>(dense);
+        denseToSlot.pop_back();
+
+        Release(slot);
+
+        removed = static_cast<uint32_t>(dense);
+        return true;
+    }
+
+    SlotHandle HandleAt(uint32_t dense) const {
+        uint32_t slot = denseToSlot[dense];
+        return MakeHandle(slot, slots[slot].generation);
+    }
+
+    size_t Size() const { return denseToSlot.size(); }
+
+    void Clear() {
+        // Keep generations so handles from before the clear stay invalid
+        for (uint32_t slot : denseToSlot) {
+            Release(slot);
+        }
+        denseToSlot.clear();
+    }
+
+private:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    struct Slot {
+        uint32_t dense;        // dense index while alive, NONE while free
+        uint32_t generation;
+    };
+
+    // Bump the generation so every outstanding copy of the slot's handle goes stale. A slot
+    // out of generations is retired instead of wrapping, which could revive a stale handle.
+    void Release(uint32_t slot) {
+        slots[slot].dense = NONE;
+        if (slots[slot].generation < MAX_GENERATION) {
+            slots[slot].generation++;
+            freeSlots.push_back(slot);
+        }
+    }
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> denseToSlot;
+    std::vector<uint32_t> freeSlots;
+};
+
+// Slot map storing T contiguously, addressed by generation-checked handles
+template<typename T>
+class SlotMap {
+public:
+    SlotHandle Insert(const T& value) {
+        SlotHandle handle = index.Create();
+        items.push_back(value);
+        return handle;
+    }
+
+    bool Remove(SlotHandle handle) {
+        uint32_t removed;
+        if (!index.Remove(handle, removed)) {
+            return false;
+        }
+        if (removed != items.size() - 1) {
+            items[removed] = std::move(items.back());
+        }
+        items.pop_back();
+        return true;
+    }
+
+    T* Get(SlotHandle handle) {
+        int dense = index.Find(handle);
+        return dense >= 0 ? &items[dense] : nullptr;
+    }
+
+    const T* Get(SlotHandle handle) const {
+        int dense = index.Find(handle);
+        return dense >= 0 ? &items[dense] : nullptr;
+    }
+
+    bool Contains(SlotHandle handle) const { return index.Contains(handle); }
+    int Find(SlotHandle handle) const { return index.Find(handle); }
+    SlotHandle HandleAt(size_t dense) const { return index.HandleAt(static_cast<uint32_t>(dense)); }
+
+    void Clear() {
+        index.Clear();
+        items.clear();
+    }
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    // Dense storage, iteration order changes when elements are removed
+    std::vector<T>& Dense() { return items; }
+    const std::vector<T>& Dense() const { return items; }
+    T& operator[](size_t dense) { return items[dense]; }
+    const T& operator[](size_t dense) const { return items[dense]; }
+    typename std::vector<T>::iterator begin() { return items.begin(); }
+    typename std::vector<T>::iterator end() { return items.end(); }
+    typename std::vector<T>::const_iterator begin() const { return items.begin(); }
+    typename std::vector<T>::const_iterator end() const { return items.end(); }
+
+private:
+    SlotIndex index;
+    std::vector<T> items;
+};
+
+#endif //QENGINE_SLOTMAP_H
@@ -7,6 +7,7 @@ struct Sprite {
     GLuint textureID;
     float x, y;
     float width, height;
+    float r = 1.0f, g = 1.0f, b = 1.0f, a = 1.0f; // tint (white = no tint)
 };
 
 #endif // SPRITE_H
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef QENGINE_SPRITESTORE_H
+#define QENGINE_SPRITESTORE_H
+
+#include <optional>
+#include <GL/glew.h>
+#include "Sprite.h"
+#include "SlotMap.h"
+#include "AlignedAllocator.h"
+
+// Float columns of the sprite store, same order as the Sprite fields
+enum SpriteColumn : unsigned char {
+    COLUMN_X,
+    COLUMN_Y,
+    COLUMN_WIDTH,
+    COLUMN_HEIGHT,
+    COLUMN_R,
+    COLUMN_G,
+    COLUMN_B,
+    COLUMN_A,
+    SPRITE_COLUMN_COUNT
+};
+
+// Compatibility view of one sprite inside the store, reads and writes go straight to the columns
+struct SpriteRef {
+    GLuint& textureID;
+    float& x;
+    float& y;
+    float& width;
+    float& height;
+    float& r;
+    float& g;
+    float& b;
+    float& a;
+
+    operator Sprite() const {
+        return {textureID, x, y, width, height, r, g, b, a};
+    }
+
+    SpriteRef& operator=(const Sprite& sprite) {
+        textureID = sprite.textureID;
+        x = sprite.x; y = sprite.y;
+        width = sprite.width; height = sprite.height;
+        r = sprite.r; g = sprite.g; b = sprite.b; a = sprite.a;
+        return *this;
+    }
+};
+
+// Engine sprite storage: generation-checked handles over a dense, 64-byte aligned
+// structure-of-arrays, so hot loops only stream the columns they use.
+class SpriteStore {
+public:
+    SlotHandle Insert(const Sprite& sprite);
+    bool Remove(SlotHandle handle);
+    void Clear();
+
+    int Find(SlotHandle handle) const { return index.Find(handle); }
+    bool Contains(SlotHandle handle) const { return index.Contains(handle); }
+    SlotHandle HandleAt(size_t dense) const { return index.HandleAt(static_cast<uint32_t>(dense)); }
+
+    size_t size() const { return textureIDs.size(); }
+    bool empty() const { return textureIDs.empty(); }
+
+    // AoS-style access for code that works on whole sprites
+    std::optional<SpriteRef> Get(SlotHandle handle);
+    SpriteRef operator[](size_t dense);
+    Sprite Load(size_t dense) const;
+
+    // Raw columns in dense order, valid until the next Insert/Remove
+    float* Column(SpriteColumn column) { return columns[column].data(); }
+    const float* Column(SpriteColumn column) const { return columns[column].data(); }
+    GLuint* TextureIDs() { return textureIDs.data(); }
+    const GLuint* TextureIDs() const { return textureIDs.data(); }
+
+    float* X() { return Column(COLUMN_X); }
+    float* Y() { return Column(COLUMN_Y); }
+    float* Width() { return Column(COLUMN_WIDTH); }
+    float* Height() { return Column(COLUMN_HEIGHT); }
+    const float* X() const { return Column(COLUMN_X); }
+    const float* Y() const { return Column(COLUMN_Y); }
+    const float* Width() const { return Column(COLUMN_WIDTH); }
+    const float* Height() const { return Column(COLUMN_HEIGHT); }
+
+    // FNV-1a over the handles and float columns, used to check that replays stay in sync.
+    // Texture ids are left out since they come from the driver.
+    uint64_t Checksum() const;
+
+private:
+    SlotIndex index;
+    AlignedVector<GLuint> textureIDs;
+    AlignedVector<float> columns[SPRITE_COLUMN_COUNT];
+};
+
+#endif //QENGINE_SPRITESTORE_H
@@ -0,0 +1,47 @@
+#ifndef QENGINE_SYSTEMS_H
+#define QENGINE_SYSTEMS_H
+
+#include <vector>
+#include <utility>
+#include "World.h"
+#include "Collision.h"
+#include "Timestep.h"
+
+// Engine systems, each iterates only the components it needs
+
+class MovementSystem {
+public:
+    static void Update(World& world, float deltaTime);
+};
+
+class AnimationSystem {
+public:
+    static void Update(World& world, float deltaTime);
+};
+
+class CollisionSystem {
+public:
+    // Test every Collider against the others and push solid pairs apart
+    static void Update(World& world);
+
+    // Overlapping collider pairs found by the last Update
+    static const std::vector<std::pair<Entity, Entity>>& Contacts() { return contacts; }
+
+private:
+    static std::vector<std::pair<Entity, Entity>> contacts;
+};
+
+class RenderSystem {
+public:
+    // Cull to the region, blend with the previous tick and order by Layer
+    static void BuildRenderList(World& world, const SpriteStore& previous, float alpha,
+                                const AABB& region, std::vector<Sprite>& out);
+
+    static size_t CulledCount() { return culled; }
+
+private:
+    static std::vector<int> visible;
+    static size_t culled;
+};
+
+#endif //QENGINE_SYSTEMS_H
@@ -3,6 +3,7 @@
 
 #include <GL/glew.h>
 #include <string>
+#include <cstddef>
 
 // The main function that takes a std::string (defined in .cpp)
 GLuint LoadTexture(const std::string& filePath);
@@ -12,4 +13,20 @@ inline GLuint LoadTexture(const char* filePath) {
     return LoadTexture(std::string(filePath));
 }
 
+// Free a texture returned by LoadTexture. The snapshot being drawn may still use it,
+// so the GL name is only deleted by the next DeleteReleasedTextures.
+void ReleaseTexture(GLuint textureID);
+
+// Delete the textures released so far. Main thread only, once the simulation is idle and
+// no snapshot that is still to be drawn references them.
+void DeleteReleasedTextures();
+
+// Estimated GPU memory of live textures from LoadTexture, in bytes (RGBA8 plus mipmaps)
+size_t GetTextureMemory();
+
+// Headless mode: LoadTexture only checks the image header and hands out ids with
+// no GPU storage, so scripts run unchanged without a GL context
+void SetHeadlessTextures(bool headless);
+bool IsHeadlessTextures();
+
 #endif
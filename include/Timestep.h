@@ -0,0 +1,35 @@
+#ifndef QENGINE_TIMESTEP_H
+#define QENGINE_TIMESTEP_H
+
+#include <vector>
+#include "SpriteStore.h"
+
+// Fixed-rate simulation clock driven by the variable frame delta
+class FixedTimestep {
+public:
+    explicit FixedTimestep(float tickRate = 60.0f, int maxStepsPerFrame = 5);
+
+    // Feed the frame delta, returns how many simulation ticks to run this frame
+    int Advance(float frameDelta);
+
+    void SetTickRate(float tickRate);
+    void SetMaxStepsPerFrame(int maxSteps);
+    float GetTickRate() const { return tickRate; }
+    float GetStep() const { return step; }
+    int GetMaxStepsPerFrame() const { return maxStepsPerFrame; }
+
+    // Fraction of a tick left in the accumulator, used to blend previous and current state
+    float GetAlpha() const { return accumulator / step; }
+
+private:
+    float tickRate;
+    float step;
+    float accumulator;
+    int maxStepsPerFrame;
+};
+
+// Blend the visible sprites (dense indices) between the last two ticks for rendering, matched by handle
+void InterpolateSprites(const SpriteStore& previous, const SpriteStore& current, float alpha,
+                        const std::vector<int>& visible, std::vector<Sprite>& out);
+
+#endif //QENGINE_TIMESTEP_H
@@ -0,0 +1,86 @@
+#ifndef QENGINE_TWEEN_H
+#define QENGINE_TWEEN_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "SpriteStore.h"
+
+// Easing curves available to tweens
+enum class EaseType : unsigned char {
+    Linear,
+    QuadIn, QuadOut, QuadInOut,
+    CubicIn, CubicOut, CubicInOut,
+    SineIn, SineOut, SineInOut,
+    BackOut,
+    ElasticOut,
+    BounceOut
+};
+
+// Sprite fields a tween can drive
+enum TweenProperty : unsigned char {
+    TWEEN_X,
+    TWEEN_Y,
+    TWEEN_WIDTH,
+    TWEEN_HEIGHT,
+    TWEEN_R,
+    TWEEN_G,
+    TWEEN_B,
+    TWEEN_A,
+    TWEEN_PROPERTY_COUNT
+};
+
+// Set of target values, only the properties in mask are animated
+struct TweenTarget {
+    float values[TWEEN_PROPERTY_COUNT] = {};
+    unsigned int mask = 0;
+
+    void Set(TweenProperty property, float value) {
+        values[property] = value;
+        mask |= 1u << property;
+    }
+};
+
+float ApplyEase(EaseType ease, float t);
+EaseType EaseFromName(const std::string& name);
+
+// Tween manager - all static methods, records are evaluated in one batched pass per tick
+class TweenManager {
+public:
+    // Start a tween, returns its id (0 on failure). If 'after' is a running tween id
+    // the new tween waits for it to finish before its delay starts counting.
+    static int TweenTo(SlotHandle sprite, const TweenTarget& target, float duration,
+                       EaseType ease = EaseType::Linear, float delay = 0.0f, int after = 0);
+
+    // Advance every active tween and write results into the sprites
+    static void Update(float deltaTime, SpriteStore& sprites);
+
+    static bool IsTweenActive(int tweenId);
+    static void CancelTween(int tweenId);
+    static void CancelSpriteTweens(SlotHandle sprite);
+    static void ClearTweens();
+    static size_t ActiveCount() { return spriteHandle.size(); }
+
+private:
+    // Structure-of-arrays tween records, one record per animated property
+    static std::vector<SlotHandle> spriteHandle;
+    static std::vector<int> tweenId;
+    static std::vector<int> waitFor;      // tween id this record is chained after (0 = none)
+    static std::vector<TweenProperty> property;
+    static std::vector<EaseType> ease;
+    static std::vector<unsigned char> started;
+    static std::vector<float> from;
+    static std::vector<float> to;
+    static std::vector<float> elapsed;
+    static std::vector<float> duration;
+    static std::vector<float> delay;
+
+    // Records still alive per tween id
+    static std::unordered_map<int, int> remaining;
+    static int nextTweenId;
+
+    static void RemoveRecord(size_t i);
+    static void FinishRecord(int id);
+};
+
+#endif //QENGINE_TWEEN_H
@@ -2,8 +2,11 @@
 #define UI_H
 
 #include <vector>
-#include "../include/Sprite.h"
+#include "../include/World.h"
 
-void RenderGUI(std::vector<Sprite>& sprites);
+void RenderGUI(World& world);
+
+// Runtime statistics: frame times, render counters, Lua cost, memory and GPU pass times
+void RenderPerformanceWindow(World& world);
 
 #endif // UI_H
\ No newline at end of file
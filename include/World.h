@@ -0,0 +1,34 @@
+#ifndef QENGINE_WORLD_H
+#define QENGINE_WORLD_H
+
+#include "SpriteStore.h"
+#include "ECS.h"
+#include "Components.h"
+
+// The engine world: every entity is a sprite in the store, extra data lives in component pools
+struct World {
+    SpriteStore sprites;
+    Registry components;
+
+    Entity Spawn(const Sprite& sprite) {
+        return sprites.Insert(sprite);
+    }
+
+    // Remove the sprite and all its components. Textures are owned by the caller.
+    bool Destroy(Entity entity) {
+        if (!sprites.Contains(entity)) {
+            return false;
+        }
+        components.DestroyEntity(entity);
+        return sprites.Remove(entity);
+    }
+
+    void Clear() {
+        components.Clear();
+        sprites.Clear();
+    }
+};
+
+extern World world;
+
+#endif //QENGINE_WORLD_H
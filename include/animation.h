@@ -37,6 +37,7 @@ public:
     static int CreateAnimation(bool loop = true);
     static bool AddFrameToAnimation(int animIndex, GLuint textureID, float duration);
     static void UpdateAnimation(int animIndex, float deltaTime);
+    static void UpdateAllAnimations(float deltaTime);
     static void PlayAnimation(int animIndex);
     static void PauseAnimation(int animIndex);
     static void StopAnimation(int animIndex);
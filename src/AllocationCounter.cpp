@@ -0,0 +1,106 @@
+#include "../include/AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+uint64_t AllocationCounter::lastFrame = 0;
+
+static std::atomic<uint64_t> totalAllocations{0};
+static std::atomic<uint64_t> totalBytes{0};
+static thread_local uint64_t threadAllocations = 0;
+static thread_local uint64_t frameStart = 0;
+
+uint64_t AllocationCounter::TotalAllocations() {
+    return totalAllocations.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::TotalBytes() {
+    return totalBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::ThreadAllocations() {
+    return threadAllocations;
+}
+
+void AllocationCounter::BeginFrame() {
+    frameStart = threadAllocations;
+}
+
+uint64_t AllocationCounter::EndFrame() {
+    lastFrame = threadAllocations - frameStart;
+    return lastFrame;
+}
+
+#if COUNT_ALLOCATIONS
+// Global operator new/delete replacements, every C++ heap allocation in the process passes through here
+static void* CountedAllocate(size_t size, size_t alignment) {
+    totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(size, std::memory_order_relaxed);
+    threadAllocations++;
+
+    if (size == 0) {
+        size = 1;
+    }
+    void* pointer;
+#ifdef _WIN32
+    pointer = alignment > alignof(std::max_align_t) ? _aligned_malloc(size, alignment) : std::malloc(size);
+#else
+    pointer = alignment > alignof(std::max_align_t) ? std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1))
+                                                    : std::malloc(size);
+#endif
+    return pointer;
+}
+
+static void CountedFree(void* pointer, size_t alignment) {
+#ifdef _WIN32
+    if (alignment > alignof(std::max_align_t)) {
+        _aligned_free(pointer);
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+    std::free(pointer);
+}
+
+void* operator new(size_t size) {
+    void* pointer = CountedAllocate(size, alignof(std::max_align_t));
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    void* pointer = CountedAllocate(size, alignof(std::max_align_t));
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    void* pointer = CountedAllocate(size, static_cast<size_t>(alignment));
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    void* pointer = CountedAllocate(size, static_cast<size_t>(alignment));
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size, alignof(std::max_align_t));
+}
+
+void operator delete(void* pointer) noexcept { CountedFree(pointer, alignof(std::max_align_t)); }
+void operator delete[](void* pointer) noexcept { CountedFree(pointer, alignof(std::max_align_t)); }
+void operator delete(void* pointer, size_t) noexcept { CountedFree(pointer, alignof(std::max_align_t)); }
+void operator delete[](void* pointer, size_t) noexcept { CountedFree(pointer, alignof(std::max_align_t)); }
+void operator delete(void* pointer, std::align_val_t alignment) noexcept { CountedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept { CountedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete(void* pointer, size_t, std::align_val_t alignment) noexcept { CountedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete[](void* pointer, size_t, std::align_val_t alignment) noexcept { CountedFree(pointer, static_cast<size_t>(alignment)); }
+#endif
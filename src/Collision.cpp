@@ -84,8 +84,9 @@ std::vector<CollisionInfo> CollisionManager::GetAllCollisions(const std::vector<
     return collisions;
 }
 
-// Resolve collision by pushing sprites apart
-void CollisionManager::ResolveCollision(Sprite& a, Sprite& b, const CollisionInfo& info) {
+// Push two sprites apart, shared by the Sprite and SpriteRef overloads
+template<typename T>
+static void SeparateSprites(T& a, T& b, const CollisionInfo& info) {
     // Push sprites apart on the axis with least overlap
     if (info.overlapX < info.overlapY) {
         // Separate on X axis
@@ -110,8 +111,141 @@ void CollisionManager::ResolveCollision(Sprite& a, Sprite& b, const CollisionInf
     }
 }
 
+// Resolve collision by pushing sprites apart
+void CollisionManager::ResolveCollision(Sprite& a, Sprite& b, const CollisionInfo& info) {
+    SeparateSprites(a, b, info);
+}
+
+void CollisionManager::ResolveCollision(SpriteRef a, SpriteRef b, const CollisionInfo& info) {
+    SeparateSprites(a, b, info);
+}
+
 // Point in sprite check
 bool CollisionManager::PointInSprite(float x, float y, const Sprite& sprite) {
     return (x >= sprite.x && x <= sprite.x + sprite.width &&
             y >= sprite.y && y <= sprite.y + sprite.height);
-}
\ No newline at end of file
+}
+
+// Sprites are tested in blocks: a branch-free pass over the columns fills a hit mask
+// (vectorizes), then the few hits are compacted.
+static const size_t COLLISION_BLOCK = 256;
+
+template<bool Centered>
+static void OverlapMask(const AABB& box, const float* __restrict x, const float* __restrict y,
+                        const float* __restrict w, const float* __restrict h,
+                        size_t count, unsigned char* __restrict mask) {
+    const float left = box.x;
+    const float top = box.y;
+    const float right = box.x + box.width;
+    const float bottom = box.y + box.height;
+
+    for (size_t i = 0; i < count; i++) {
+        float sx = x[i];
+        float sy = y[i];
+        if constexpr (Centered) {
+            sx -= w[i] * 0.5f;
+            sy -= h[i] * 0.5f;
+        }
+        mask[i] = (unsigned char)((sx < right) & (sx + w[i] > left) &
+                                  (sy < bottom) & (sy + h[i] > top));
+    }
+}
+
+// Call fn(denseIndex) for every sprite in [first, count) overlapping the box, stops when fn returns false.
+// Centered takes each sprite's x, y as its center rather than its top-left corner.
+template<bool Centered = false, typename F>
+static void ForEachOverlap(const AABB& box, const SpriteStore& sprites, size_t first, F&& fn) {
+    unsigned char mask[COLLISION_BLOCK];
+    const float* x = sprites.X();
+    const float* y = sprites.Y();
+    const float* w = sprites.Width();
+    const float* h = sprites.Height();
+    size_t count = sprites.size();
+
+    for (size_t begin = first; begin < count; begin += COLLISION_BLOCK) {
+        size_t n = std::min(COLLISION_BLOCK, count - begin);
+        OverlapMask<Centered>(box, x + begin, y + begin, w + begin, h + begin, n, mask);
+        for (size_t i = 0; i < n; i++) {
+            if (mask[i] && !fn(static_cast<int>(begin + i))) {
+                return;
+            }
+        }
+    }
+}
+
+int CollisionManager::FindFirstCollision(const AABB& box, const SpriteStore& sprites, int ignoreIndex) {
+    int found = -1;
+    ForEachOverlap(box, sprites, 0, [&](int i) {
+        if (i == ignoreIndex) {
+            return true;
+        }
+        found = i;
+        return false;
+    });
+    return found;
+}
+
+// Shared by the std::vector and arena overloads, Out only needs push_back
+template<typename Out>
+static void CollectCollisions(const AABB& box, const SpriteStore& sprites, int ignoreIndex, Out& collisions) {
+    ForEachOverlap(box, sprites, 0, [&](int i) {
+        if (i != ignoreIndex) {
+            collisions.push_back(i);
+        }
+        return true;
+    });
+}
+
+template<typename Out>
+static void CollectAllPairs(const SpriteStore& sprites, Out& collisions) {
+    for (size_t i = 0; i < sprites.size(); i++) {
+        AABB a = AABB::FromStore(sprites, i);
+        ForEachOverlap(a, sprites, i + 1, [&](int j) {
+            AABB b = AABB::FromStore(sprites, j);
+            float overlapX = std::min((a.x + a.width) - b.x, (b.x + b.width) - a.x);
+            float overlapY = std::min((a.y + a.height) - b.y, (b.y + b.height) - a.y);
+            collisions.push_back(CollisionInfo(static_cast<int>(i), j, overlapX, overlapY));
+            return true;
+        });
+    }
+}
+
+std::vector<int> CollisionManager::FindAllCollisions(const AABB& box, const SpriteStore& sprites, int ignoreIndex) {
+    std::vector<int> collisions;
+    CollectCollisions(box, sprites, ignoreIndex, collisions);
+    return collisions;
+}
+
+std::vector<CollisionInfo> CollisionManager::GetAllCollisions(const SpriteStore& sprites) {
+    std::vector<CollisionInfo> collisions;
+    CollectAllPairs(sprites, collisions);
+    return collisions;
+}
+
+std::span<int> CollisionManager::FindAllCollisions(const AABB& box, const SpriteStore& sprites, FrameArena& arena, int ignoreIndex) {
+    ArenaVector<int> collisions(arena);
+    CollectCollisions(box, sprites, ignoreIndex, collisions);
+    return collisions.Span();
+}
+
+std::span<CollisionInfo> CollisionManager::GetAllCollisions(const SpriteStore& sprites, FrameArena& arena) {
+    ArenaVector<CollisionInfo> collisions(arena);
+    CollectAllPairs(sprites, collisions);
+    return collisions.Span();
+}
+
+void CollisionManager::FindInRegion(const AABB& region, const SpriteStore& sprites, std::vector<int>& out) {
+    out.clear();
+    ForEachOverlap(region, sprites, 0, [&](int i) {
+        out.push_back(i);
+        return true;
+    });
+}
+
+void CollisionManager::FindVisible(const AABB& region, const SpriteStore& sprites, std::vector<int>& out) {
+    out.clear();
+    ForEachOverlap<true>(region, sprites, 0, [&](int i) {
+        out.push_back(i);
+        return true;
+    });
+}
@@ -0,0 +1,221 @@
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+#include "../include/LuaCompat.h"
+#include "../include/CoroutineScheduler.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+SlotMap<CoroutineScheduler::Coroutine> CoroutineScheduler::coroutines;
+
+namespace {
+
+// Wake-up entry, ordered by 'when' and then by the order the waits were made,
+// so coroutines due on the same tick resume in a fixed order
+template<typename Time>
+struct WakeEntry {
+    Time when;
+    uint64_t sequence;
+    SlotHandle handle;
+
+    // std heaps are max-heaps, so compare reversed to keep the earliest on top
+    bool operator<(const WakeEntry& other) const {
+        return when != other.when ? when > other.when : sequence > other.sequence;
+    }
+};
+
+std::vector<WakeEntry<double>> timers;
+std::vector<WakeEntry<uint64_t>> tickWaits;
+std::unordered_map<std::string, std::vector<SlotHandle>> signalWaits;
+std::vector<SlotHandle> signaled;
+
+// Resumed this tick, reused so Update does not allocate
+std::vector<SlotHandle> due;
+
+double clockSeconds = 0.0;
+uint64_t tick = 0;
+uint64_t nextSequence = 0;
+
+SlotHandle current = INVALID_HANDLE;
+
+// Move every entry due by 'now' into 'due', before any of them run, so a
+// coroutine waiting again from inside Update is not resumed twice in one tick
+template<typename Time>
+void PopDue(std::vector<WakeEntry<Time>>& heap, Time now) {
+    while (!heap.empty() && heap.front().when <= now) {
+        std::pop_heap(heap.begin(), heap.end());
+        due.push_back(heap.back().handle);
+        heap.pop_back();
+    }
+}
+
+void PushTickWait(SlotHandle handle, int ticks) {
+    tickWaits.push_back({tick + (uint64_t)std::max(ticks, 1), nextSequence++, handle});
+    std::push_heap(tickWaits.begin(), tickWaits.end());
+}
+
+} // namespace
+
+SlotHandle CoroutineScheduler::Start(lua_State* L, int nargs) {
+    lua_State* thread = lua_newthread(L);
+    int ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    lua_xmove(L, thread, nargs + 1);
+
+    SlotHandle handle = coroutines.Insert({thread, ref, WaitKind::None, false, false});
+    Resume(L, handle, WaitKind::None, nargs);
+    return handle;
+}
+
+bool CoroutineScheduler::Stop(lua_State* L, SlotHandle handle) {
+    Coroutine* co = coroutines.Get(handle);
+    if (!co) {
+        return false;
+    }
+    // Its thread is still on the C stack, Resume finishes it when it yields
+    if (co->running) {
+        co->stopRequested = true;
+        return true;
+    }
+    Finish(L, handle);
+    return true;
+}
+
+CoroutineScheduler::Coroutine* CoroutineScheduler::Running(lua_State* co) {
+    Coroutine* running = coroutines.Get(current);
+    return running && running->thread == co ? running : nullptr;
+}
+
+bool CoroutineScheduler::WaitSeconds(lua_State* co, double seconds) {
+    Coroutine* running = Running(co);
+    if (!running) {
+        return false;
+    }
+    running->wait = WaitKind::Time;
+    timers.push_back({clockSeconds + seconds, nextSequence++, current});
+    std::push_heap(timers.begin(), timers.end());
+    return true;
+}
+
+bool CoroutineScheduler::WaitTicks(lua_State* co, int ticks) {
+    Coroutine* running = Running(co);
+    if (!running) {
+        return false;
+    }
+    running->wait = WaitKind::Ticks;
+    PushTickWait(current, ticks);
+    return true;
+}
+
+bool CoroutineScheduler::WaitSignal(lua_State* co, const std::string& signal) {
+    Coroutine* running = Running(co);
+    if (!running) {
+        return false;
+    }
+    running->wait = WaitKind::Signal;
+    signalWaits[signal].push_back(current);
+    return true;
+}
+
+int CoroutineScheduler::Signal(const std::string& signal) {
+    auto waiting = signalWaits.find(signal);
+    if (waiting == signalWaits.end()) {
+        return 0;
+    }
+    // Lists can still hold coroutines stopped while waiting
+    int woken = 0;
+    for (SlotHandle handle : waiting->second) {
+        if (coroutines.Contains(handle)) {
+            signaled.push_back(handle);
+            woken++;
+        }
+    }
+    signalWaits.erase(waiting);
+    return woken;
+}
+
+void CoroutineScheduler::Update(lua_State* L, float step) {
+    QE_PROFILE_FUNCTION();
+    clockSeconds += step;
+    tick++;
+
+    due.clear();
+    PopDue(timers, clockSeconds);
+    size_t timersDue = due.size();
+    PopDue(tickWaits, tick);
+    size_t ticksDue = due.size();
+    // Signals raised by the coroutines resumed below wake their waiters next tick
+    due.insert(due.end(), signaled.begin(), signaled.end());
+    signaled.clear();
+
+    // Resume appends nothing to 'due', so indexing stays valid
+    for (size_t i = 0; i < due.size(); i++) {
+        WaitKind expected = i < timersDue ? WaitKind::Time : i < ticksDue ? WaitKind::Ticks : WaitKind::Signal;
+        Resume(L, due[i], expected, 0);
+    }
+}
+
+void CoroutineScheduler::Resume(lua_State* from, SlotHandle handle, WaitKind expected, int nargs) {
+    Coroutine* co = coroutines.Get(handle);
+    // Stopped, or a leftover entry from a wait it is no longer in
+    if (!co || co->running || co->wait != expected) {
+        return;
+    }
+    lua_State* thread = co->thread;
+    co->wait = WaitKind::None;
+    co->running = true;
+
+    // A thread only inherits the hook at creation, so a profiler started or stopped since
+    // would miss or keep sampling it
+    lua_Hook hook = lua_gethook(from);
+    int mask = lua_gethookmask(from);
+    int count = lua_gethookcount(from);
+    if (lua_gethook(thread) != hook || lua_gethookmask(thread) != mask || lua_gethookcount(thread) != count) {
+        lua_sethook(thread, hook, mask, count);
+    }
+
+    SlotHandle previous = current;
+    current = handle;
+    int nresults = 0;
+    int status = LuaResume(thread, from, nargs, &nresults);
+    current = previous;
+
+    // Coroutines started from inside may have moved it
+    co = coroutines.Get(handle);
+    co->running = false;
+    if (status == LUA_YIELD && !co->stopRequested) {
+        lua_pop(thread, nresults);
+        if (co->wait == WaitKind::None) {
+            co->wait = WaitKind::Ticks;
+            PushTickWait(handle, 1);
+        }
+        return;
+    }
+    if (status != LUA_OK && status != LUA_YIELD) {
+        luaL_traceback(from, thread, lua_tostring(thread, -1), 0);
+        std::cerr << "Coroutine error: " << lua_tostring(from, -1) << std::endl;
+        lua_pop(from, 1);
+    }
+    Finish(from, handle);
+}
+
+void CoroutineScheduler::Finish(lua_State* L, SlotHandle handle) {
+    luaL_unref(L, LUA_REGISTRYINDEX, coroutines.Get(handle)->ref);
+    coroutines.Remove(handle);
+}
+
+void CoroutineScheduler::Clear(lua_State* L) {
+    for (size_t i = 0; i < coroutines.size(); i++) {
+        luaL_unref(L, LUA_REGISTRYINDEX, coroutines[i].ref);
+    }
+    coroutines.Clear();
+    timers.clear();
+    tickWaits.clear();
+    signalWaits.clear();
+    signaled.clear();
+    clockSeconds = 0.0;
+    tick = 0;
+}
@@ -0,0 +1,81 @@
+#include "../include/FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+
+FrameArena frameArena;
+
+static size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+FrameArena::FrameArena(size_t size)
+    : block(new unsigned char[size]), capacity(size), used(0), highWater(0),
+      overflowUsed(0), overflowOffset(0), overflowCapacity(0), top(nullptr) {
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(block.get());
+    size_t offset = AlignUp(base + used, alignment) - base;
+
+    if (offset + size <= capacity) {
+        used = offset + size;
+        top = block.get() + offset;
+        highWater = std::max(highWater, Used());
+        return top;
+    }
+
+    // Out of space, carve from an overflow block (merged into the main block on Reset)
+    unsigned char* current = overflow.empty() ? nullptr : overflow.back().get();
+    uintptr_t overflowBase = reinterpret_cast<uintptr_t>(current);
+    size_t overflowAligned = current ? AlignUp(overflowBase + overflowOffset, alignment) - overflowBase : 0;
+
+    if (!current || overflowAligned + size > overflowCapacity) {
+        overflowCapacity = std::max(capacity, size + alignment);
+        overflow.emplace_back(new unsigned char[overflowCapacity]);
+        current = overflow.back().get();
+        overflowBase = reinterpret_cast<uintptr_t>(current);
+        overflowAligned = AlignUp(overflowBase, alignment) - overflowBase;
+        // Padding is counted from the start of the new block, not the old one's fill
+        overflowOffset = 0;
+    }
+
+    overflowUsed += (overflowAligned - overflowOffset) + size;
+    overflowOffset = overflowAligned + size;
+    top = current + overflowAligned;
+    highWater = std::max(highWater, Used());
+    return top;
+}
+
+void* FrameArena::Reallocate(void* pointer, size_t oldSize, size_t newSize, size_t alignment) {
+    unsigned char* bytes = static_cast<unsigned char*>(pointer);
+
+    // Growing the last allocation of the main block is free
+    if (bytes && bytes == top && bytes >= block.get() && bytes < block.get() + capacity) {
+        size_t offset = bytes - block.get();
+        if (offset + newSize <= capacity) {
+            used = offset + newSize;
+            highWater = std::max(highWater, Used());
+            return bytes;
+        }
+    }
+
+    void* moved = Allocate(newSize, alignment);
+    if (bytes && oldSize) {
+        std::memcpy(moved, bytes, std::min(oldSize, newSize));
+    }
+    return moved;
+}
+
+void FrameArena::Reset() {
+    if (!overflow.empty()) {
+        // Last frame did not fit, grow once to the peak so the next one does
+        capacity = AlignUp(highWater + highWater / 2, 4096);
+        block.reset(new unsigned char[capacity]);
+        overflow.clear();
+    }
+    used = 0;
+    overflowUsed = 0;
+    overflowOffset = 0;
+    overflowCapacity = 0;
+    top = nullptr;
+}
@@ -0,0 +1,101 @@
+#include "../include/FramePipeline.h"
+#include "../include/Profiler.h"
+#include <GL/glew.h>
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+FramePipeline::FramePipeline()
+    : front(0), pending(false), ready(false), quit(false), frameDelta(0.0f) {
+}
+
+FramePipeline::~FramePipeline() {
+    Stop();
+}
+
+void FramePipeline::Start(SimulateFn fn, bool threaded, GLFWwindow* loaderContext) {
+    Stop();
+    simulate = std::move(fn);
+    pending = false;
+    ready = false;
+    quit = false;
+
+    if (threaded) {
+        worker = std::thread(&FramePipeline::WorkerLoop, this, loaderContext);
+    }
+}
+
+void FramePipeline::Stop() {
+    if (!worker.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    kicked.notify_one();
+    worker.join();
+}
+
+void FramePipeline::Kick(float deltaTime) {
+    if (!worker.joinable()) {
+        // Serial mode, simulate right away into the back buffer
+        simulate(deltaTime, snapshots[1 - front]);
+        ready = true;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        frameDelta = deltaTime;
+        pending = true;
+    }
+    kicked.notify_one();
+}
+
+void FramePipeline::Wait() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return !pending; });
+    }
+
+    if (ready) {
+        front = 1 - front;
+        ready = false;
+    }
+}
+
+void FramePipeline::WorkerLoop(GLFWwindow* loaderContext) {
+    QE_PROFILE_THREAD("Simulation");
+    if (loaderContext) {
+        glfwMakeContextCurrent(loaderContext);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        kicked.wait(lock, [this] { return pending || quit; });
+        if (quit) {
+            break;
+        }
+
+        float deltaTime = frameDelta;
+        lock.unlock();
+
+        simulate(deltaTime, snapshots[1 - front]);
+
+        // Make textures created on the loader context visible to the render context
+        if (loaderContext) {
+            QE_PROFILE_SCOPE("LoaderFinish");
+            glFinish();
+        }
+
+        lock.lock();
+        pending = false;
+        ready = true;
+        finished.notify_one();
+    }
+
+    if (loaderContext) {
+        glfwMakeContextCurrent(nullptr);
+    }
+}
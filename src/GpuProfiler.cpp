@@ -0,0 +1,133 @@
+#include "../include/GpuProfiler.h"
+#include "../include/Profiler.h"
+#include <cstring>
+
+GpuProfiler::PassQuery GpuProfiler::queries[QUERY_FRAMES][MAX_PASSES];
+int GpuProfiler::passCount[QUERY_FRAMES] = {};
+uint64_t GpuProfiler::frameIndex = 0;
+bool GpuProfiler::passOpen = false;
+bool GpuProfiler::initialized = false;
+std::vector<GpuPassTiming> GpuProfiler::timings;
+
+static const GLuint64 MAX_PLAUSIBLE_NS = 1000000000ull;
+
+void GpuProfiler::Initialize() {
+    if (initialized) {
+        return;
+    }
+    for (int f = 0; f < QUERY_FRAMES; f++) {
+        for (int p = 0; p < MAX_PASSES; p++) {
+            queries[f][p] = {nullptr, 0, 0, false};
+            glGenQueries(1, &queries[f][p].query);
+        }
+        passCount[f] = 0;
+    }
+    frameIndex = 0;
+    passOpen = false;
+    initialized = true;
+}
+
+void GpuProfiler::Shutdown() {
+    if (!initialized) {
+        return;
+    }
+    for (int f = 0; f < QUERY_FRAMES; f++) {
+        for (int p = 0; p < MAX_PASSES; p++) {
+            glDeleteQueries(1, &queries[f][p].query);
+        }
+    }
+    timings.clear();
+    initialized = false;
+}
+
+void GpuProfiler::BeginFrame() {
+    if (!initialized) {
+        return;
+    }
+    // Read whatever earlier frames have finished, oldest first
+    for (int age = QUERY_FRAMES - 1; age >= 1; age--) {
+        if (frameIndex >= (uint64_t)age) {
+            Collect(static_cast<int>((frameIndex - age) % QUERY_FRAMES));
+        }
+    }
+
+    // This frame's slot was issued QUERY_FRAMES ago. Anything still pending there means
+    // the GPU is that far behind; the query is simply reused and that sample dropped.
+    int frame = static_cast<int>(frameIndex % QUERY_FRAMES);
+    for (int p = 0; p < passCount[frame]; p++) {
+        queries[frame][p].pending = false;
+    }
+    passCount[frame] = 0;
+}
+
+void GpuProfiler::EndFrame() {
+    if (!initialized) {
+        return;
+    }
+    if (passOpen) {
+        EndPass();
+    }
+    frameIndex++;
+}
+
+void GpuProfiler::BeginPass(const char* name) {
+    int frame = static_cast<int>(frameIndex % QUERY_FRAMES);
+    if (!initialized || passOpen || passCount[frame] >= MAX_PASSES) {
+        return;
+    }
+    PassQuery& pass = queries[frame][passCount[frame]++];
+    pass.name = name;
+    pass.cpuStart = Profiler::Now();
+    pass.pending = true;
+    glBeginQuery(GL_TIME_ELAPSED, pass.query);
+    passOpen = true;
+}
+
+void GpuProfiler::EndPass() {
+    if (!initialized || !passOpen) {
+        return;
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    passOpen = false;
+}
+
+void GpuProfiler::Collect(int frame) {
+    for (int p = 0; p < passCount[frame]; p++) {
+        PassQuery& pass = queries[frame][p];
+        if (!pass.pending) {
+            continue;
+        }
+        GLint available = 0;
+        glGetQueryObjectiv(pass.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            continue;
+        }
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(pass.query, GL_QUERY_RESULT, &elapsed);
+        pass.pending = false;
+
+        // Mesa llvmpipe reports its clock epoch for the first query of a context,
+        // no real pass takes a second
+        if (elapsed > MAX_PLAUSIBLE_NS) {
+            continue;
+        }
+
+        Store(pass.name, static_cast<float>(elapsed / 1.0e6));
+        if (Profiler::Enabled()) {
+            Profiler::RecordGpu(pass.name, pass.cpuStart, pass.cpuStart + elapsed);
+        }
+    }
+}
+
+void GpuProfiler::Store(const char* name, float milliseconds) {
+    for (GpuPassTiming& timing : timings) {
+        if (timing.name == name || std::strcmp(timing.name, name) == 0) {
+            timing.milliseconds = milliseconds;
+            timing.samples++;
+            timing.average += (milliseconds - timing.average) / static_cast<float>(timing.samples);
+            return;
+        }
+    }
+    timings.push_back({name, milliseconds, milliseconds, 1});
+}
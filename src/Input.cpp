@@ -0,0 +1,145 @@
+#include "../include/Input.h"
+#include "../include/InputRecorder.h"
+
+InputManager::InputState InputManager::live;
+InputManager::InputState InputManager::frame;
+
+// Live input: forwarded to the recorder, ignored while a replay is driving the state
+static void Deliver(const InputEvent& event) {
+    if (InputRecorder::IsReplaying()) {
+        return;
+    }
+    if (InputRecorder::IsRecording()) {
+        InputRecorder::RecordEvent(event);
+    }
+    InputManager::Apply(event);
+}
+
+void InputManager::Install(GLFWwindow* window) {
+    glfwSetKeyCallback(window, KeyCallback);
+    glfwSetMouseButtonCallback(window, MouseButtonCallback);
+    glfwSetCursorPosCallback(window, CursorPosCallback);
+    glfwSetWindowFocusCallback(window, FocusCallback);
+
+    // Starting position goes through Deliver so recordings capture it too
+    double x, y;
+    glfwGetCursorPos(window, &x, &y);
+    Deliver({INPUT_CURSOR, 0, 0, x, y});
+}
+
+bool InputManager::IsKeyDown(int key) {
+    return key >= 0 && key < KEY_COUNT && frame.keysDown[key];
+}
+
+bool InputManager::IsMouseButtonDown(int button) {
+    return button >= 0 && button < MOUSE_BUTTON_COUNT && frame.buttonsDown[button];
+}
+
+bool InputManager::WasKeyPressed(int key) {
+    return key >= 0 && key < KEY_COUNT && frame.keysPressed[key];
+}
+
+bool InputManager::WasKeyReleased(int key) {
+    return key >= 0 && key < KEY_COUNT && frame.keysReleased[key];
+}
+
+bool InputManager::WasMouseButtonPressed(int button) {
+    return button >= 0 && button < MOUSE_BUTTON_COUNT && frame.buttonsPressed[button];
+}
+
+bool InputManager::WasMouseButtonReleased(int button) {
+    return button >= 0 && button < MOUSE_BUTTON_COUNT && frame.buttonsReleased[button];
+}
+
+void InputManager::BeginFrame() {
+    // Edges no tick has seen yet stay latched alongside the new ones
+    frame.keysPressed |= live.keysPressed;
+    frame.keysReleased |= live.keysReleased;
+    frame.buttonsPressed |= live.buttonsPressed;
+    frame.buttonsReleased |= live.buttonsReleased;
+    frame.keysDown = live.keysDown;
+    frame.buttonsDown = live.buttonsDown;
+    frame.mouseX = live.mouseX;
+    frame.mouseY = live.mouseY;
+
+    live.keysPressed.reset();
+    live.keysReleased.reset();
+    live.buttonsPressed.reset();
+    live.buttonsReleased.reset();
+}
+
+void InputManager::EndTick() {
+    frame.keysPressed.reset();
+    frame.keysReleased.reset();
+    frame.buttonsPressed.reset();
+    frame.buttonsReleased.reset();
+}
+
+void InputManager::Clear() {
+    // Report everything still held as released so scripts see a matching edge
+    live.keysReleased |= live.keysDown;
+    live.buttonsReleased |= live.buttonsDown;
+    live.keysDown.reset();
+    live.buttonsDown.reset();
+}
+
+void InputManager::Apply(const InputEvent& event) {
+    switch (event.type) {
+        case INPUT_KEY:
+            if (event.code >= KEY_COUNT) {
+                return;
+            }
+            if (event.action == GLFW_PRESS) {
+                live.keysDown.set(event.code);
+                live.keysPressed.set(event.code);
+            } else {
+                live.keysDown.reset(event.code);
+                live.keysReleased.set(event.code);
+            }
+            break;
+        case INPUT_MOUSE_BUTTON:
+            if (event.code >= MOUSE_BUTTON_COUNT) {
+                return;
+            }
+            if (event.action == GLFW_PRESS) {
+                live.buttonsDown.set(event.code);
+                live.buttonsPressed.set(event.code);
+            } else {
+                live.buttonsDown.reset(event.code);
+                live.buttonsReleased.set(event.code);
+            }
+            break;
+        case INPUT_CURSOR:
+            live.mouseX = event.x;
+            live.mouseY = event.y;
+            break;
+        case INPUT_FOCUS_LOST:
+            Clear();
+            break;
+    }
+}
+
+void InputManager::KeyCallback(GLFWwindow*, int key, int, int action, int) {
+    // GLFW_KEY_UNKNOWN is -1, repeats don't change state
+    if (key < 0 || key >= KEY_COUNT || action == GLFW_REPEAT) {
+        return;
+    }
+    Deliver({INPUT_KEY, (uint8_t)action, (uint16_t)key, 0.0, 0.0});
+}
+
+void InputManager::MouseButtonCallback(GLFWwindow*, int button, int action, int) {
+    if (button < 0 || button >= MOUSE_BUTTON_COUNT) {
+        return;
+    }
+    Deliver({INPUT_MOUSE_BUTTON, (uint8_t)action, (uint16_t)button, 0.0, 0.0});
+}
+
+void InputManager::CursorPosCallback(GLFWwindow*, double x, double y) {
+    Deliver({INPUT_CURSOR, 0, 0, x, y});
+}
+
+void InputManager::FocusCallback(GLFWwindow*, int focused) {
+    if (!focused) {
+        Deliver({INPUT_FOCUS_LOST, 0, 0, 0.0, 0.0});
+    }
+}
@@ -0,0 +1,152 @@
+#include "../include/InputRecorder.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+InputRecorder::Mode InputRecorder::mode = InputRecorder::Mode::Off;
+uint32_t InputRecorder::seed = 0;
+std::vector<InputEvent> InputRecorder::pending;
+uint64_t InputRecorder::frames = 0;
+uint64_t InputRecorder::mismatches = 0;
+
+static const char RECORDING_MAGIC[4] = {'Q', 'R', 'E', 'C'};
+// Version 2 widened the per-frame event count to 32 bits
+static const uint32_t RECORDING_VERSION = 2;
+
+static std::ofstream recordFile;
+static std::vector<unsigned char> replayData;
+static size_t replayOffset = 0;
+
+template<typename T>
+static void Write(const T& value) {
+    recordFile.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool Read(T& value) {
+    if (replayOffset + sizeof(T) > replayData.size()) {
+        return false;
+    }
+    std::memcpy(&value, replayData.data() + replayOffset, sizeof(T));
+    replayOffset += sizeof(T);
+    return true;
+}
+
+bool InputRecorder::StartRecording(const std::string& path, uint32_t recordSeed) {
+    Stop();
+    recordFile.open(path, std::ios::binary | std::ios::trunc);
+    if (!recordFile) {
+        std::cerr << "Failed to open input recording: " << path << std::endl;
+        return false;
+    }
+
+    recordFile.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    Write(RECORDING_VERSION);
+    Write(recordSeed);
+
+    mode = Mode::Recording;
+    seed = recordSeed;
+    frames = 0;
+    mismatches = 0;
+    std::cout << "Recording input to " << path << " (seed " << seed << ")" << std::endl;
+    return true;
+}
+
+bool InputRecorder::StartReplay(const std::string& path) {
+    Stop();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open input recording: " << path << std::endl;
+        return false;
+    }
+    replayData.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    replayOffset = 0;
+
+    char magic[4];
+    uint32_t version;
+    if (!Read(magic) || std::memcmp(magic, RECORDING_MAGIC, sizeof(magic)) != 0 ||
+        !Read(version) || version != RECORDING_VERSION || !Read(seed)) {
+        std::cerr << "Not a QEngine input recording: " << path << std::endl;
+        replayData.clear();
+        return false;
+    }
+
+    mode = Mode::Replaying;
+    frames = 0;
+    mismatches = 0;
+    std::cout << "Replaying input from " << path << " (seed " << seed << ")" << std::endl;
+    return true;
+}
+
+void InputRecorder::Stop() {
+    if (mode == Mode::Recording) {
+        recordFile.close();
+        std::cout << "Recorded " << frames << " frames" << std::endl;
+    } else if (mode == Mode::Replaying) {
+        std::cout << "Replayed " << frames << " frames, " << mismatches << " checksum mismatches" << std::endl;
+        replayData.clear();
+    }
+    pending.clear();
+    mode = Mode::Off;
+}
+
+void InputRecorder::RecordEvent(const InputEvent& event) {
+    pending.push_back(event);
+}
+
+bool InputRecorder::BeginFrame(float& deltaTime) {
+    if (mode == Mode::Recording) {
+        Write(deltaTime);
+        Write(static_cast<uint32_t>(pending.size()));
+        for (const InputEvent& event : pending) {
+            Write(static_cast<uint8_t>(event.type));
+            Write(event.action);
+            Write(event.code);
+            if (event.type == INPUT_CURSOR) {
+                Write(event.x);
+                Write(event.y);
+            }
+        }
+        pending.clear();
+        return true;
+    }
+
+    if (mode == Mode::Replaying) {
+        uint32_t count;
+        if (!Read(deltaTime) || !Read(count)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            InputEvent event = {};
+            uint8_t type;
+            if (!Read(type) || !Read(event.action) || !Read(event.code)) {
+                return false;
+            }
+            event.type = static_cast<InputEventType>(type);
+            if (event.type == INPUT_CURSOR && (!Read(event.x) || !Read(event.y))) {
+                return false;
+            }
+            InputManager::Apply(event);
+        }
+        return true;
+    }
+
+    return true;
+}
+
+void InputRecorder::EndFrame(uint64_t checksum) {
+    if (mode == Mode::Recording) {
+        Write(checksum);
+        frames++;
+    } else if (mode == Mode::Replaying) {
+        uint64_t expected;
+        if (Read(expected) && expected != checksum) {
+            if (mismatches == 0) {
+                std::cerr << "Replay diverged from the recording at frame " << frames << std::endl;
+            }
+            mismatches++;
+        }
+        frames++;
+    }
+}
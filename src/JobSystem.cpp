@@ -0,0 +1,236 @@
+#include "../include/JobSystem.h"
+#include "../include/Profiler.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+// Jobs are recycled from per-thread blocks of this many. A slot is only reused once its job
+// finished, a thread with every slot in flight adds another block.
+const size_t JOB_POOL_SIZE = 4096;
+
+// ParallelFor never splits into more chunks than this, keeping it well inside the job ring
+const size_t MAX_PARALLEL_CHUNKS = 1024;
+
+struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Job*> jobs;
+};
+
+std::vector<std::unique_ptr<WorkQueue>> queues;
+std::vector<std::thread> workers;
+std::atomic<bool> running{false};
+std::atomic<int> queuedJobs{0};
+std::atomic<int> sleepingWorkers{0};
+std::mutex sleepMutex;
+std::condition_variable wakeup;
+
+// Queue 0 belongs to the main thread and any other non-worker thread
+thread_local size_t queueIndex = 0;
+thread_local std::vector<std::unique_ptr<Job[]>> jobPools;
+thread_local size_t jobPoolNext = 0;
+thread_local unsigned int stealSeed = 0;
+
+Job* PopOwn() {
+    WorkQueue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) {
+        return nullptr;
+    }
+    Job* job = queue.jobs.back();
+    queue.jobs.pop_back();
+    return job;
+}
+
+Job* Steal() {
+    size_t count = queues.size();
+    stealSeed = stealSeed * 1664525u + 1013904223u;
+    size_t start = stealSeed % count;
+
+    for (size_t n = 0; n < count; n++) {
+        size_t victim = (start + n) % count;
+        if (victim == queueIndex) {
+            continue;
+        }
+        WorkQueue& queue = *queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            Job* job = queue.jobs.front();
+            queue.jobs.pop_front();
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+Job* GetJob() {
+    if (queuedJobs.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+    Job* job = PopOwn();
+    if (!job) {
+        job = Steal();
+    }
+    if (job) {
+        queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+void Finish(Job* job) {
+    // Read before the decrement, once the job finishes its owner may recycle the slot
+    Job* parent = job->parent;
+    int left = job->unfinished.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    if (left == 0 && parent) {
+        Finish(parent);
+    }
+}
+
+void Execute(Job* job) {
+    QE_PROFILE_SCOPE("Job");
+    job->function(*job);
+    Finish(job);
+}
+
+void WorkerLoop(size_t index) {
+    QE_PROFILE_THREAD("Job Worker");
+    queueIndex = index;
+    stealSeed = static_cast<unsigned int>(index * 2654435761u);
+
+    while (running.load(std::memory_order_acquire)) {
+        Job* job = GetJob();
+        if (job) {
+            Execute(job);
+            continue;
+        }
+
+        // Nothing to do, sleep until work is queued (the timeout covers a missed notify)
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers.fetch_add(1, std::memory_order_relaxed);
+        wakeup.wait_for(lock, std::chrono::milliseconds(1), [] {
+            return queuedJobs.load(std::memory_order_relaxed) > 0 || !running.load(std::memory_order_relaxed);
+        });
+        sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+void JobSystem::Initialize(unsigned workerCount) {
+    if (running.load()) {
+        return;
+    }
+
+    if (workerCount == 0) {
+        unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    queues.clear();
+    for (unsigned i = 0; i < workerCount + 1; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    running.store(true, std::memory_order_release);
+    for (unsigned i = 0; i < workerCount; i++) {
+        workers.emplace_back(WorkerLoop, i + 1);
+    }
+
+    std::cout << "Job system started with " << workerCount << " workers" << std::endl;
+}
+
+void JobSystem::Shutdown() {
+    if (!running.load()) {
+        return;
+    }
+
+    running.store(false, std::memory_order_release);
+    wakeup.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    queues.clear();
+    queuedJobs.store(0);
+}
+
+unsigned JobSystem::WorkerCount() {
+    return static_cast<unsigned>(workers.size());
+}
+
+bool JobSystem::IsRunning() {
+    return running.load(std::memory_order_acquire);
+}
+
+Job* JobSystem::AllocateJob(Job* parent) {
+    if (jobPools.empty()) {
+        jobPools.push_back(std::make_unique<Job[]>(JOB_POOL_SIZE));
+    }
+
+    // Skip slots whose job is still queued, running or waiting on children
+    size_t capacity = jobPools.size() * JOB_POOL_SIZE;
+    Job* job = nullptr;
+    for (size_t tried = 0; tried < capacity && !job; tried++) {
+        size_t slot = jobPoolNext++ % capacity;
+        Job* candidate = &jobPools[slot / JOB_POOL_SIZE][slot % JOB_POOL_SIZE];
+        if (IsFinished(candidate)) {
+            job = candidate;
+        }
+    }
+    if (!job) {
+        // All in flight. Waiting here could deadlock on a job its caller has yet to Run, so grow
+        jobPools.push_back(std::make_unique<Job[]>(JOB_POOL_SIZE));
+        job = &jobPools.back()[0];
+        jobPoolNext = capacity + 1;
+    }
+    job->function = nullptr;
+    job->parent = parent;
+    job->unfinished.store(1, std::memory_order_relaxed);
+
+    if (parent) {
+        parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+void JobSystem::Run(Job* job) {
+    if (!running.load(std::memory_order_acquire)) {
+        // No workers, run inline so callers behave the same either way
+        Execute(job);
+        return;
+    }
+
+    {
+        WorkQueue& queue = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    queuedJobs.fetch_add(1, std::memory_order_relaxed);
+    if (sleepingWorkers.load(std::memory_order_relaxed) > 0) {
+        wakeup.notify_one();
+    }
+}
+
+void JobSystem::Wait(const Job* job) {
+    while (!IsFinished(job)) {
+        Job* next = GetJob();
+        if (next) {
+            Execute(next);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+size_t JobSystem::ChunkSize(size_t count, size_t grain) {
+    size_t chunk = std::max<size_t>(grain, 1);
+    size_t minimum = (count + MAX_PARALLEL_CHUNKS - 1) / MAX_PARALLEL_CHUNKS;
+    return std::max(chunk, minimum);
+}
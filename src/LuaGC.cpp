@@ -0,0 +1,77 @@
+extern "C" {
+#include <lua.h>
+}
+#include "../include/LuaCompat.h"
+#include "../include/LuaGC.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+#if LUA_VERSION_NUM >= 504
+LuaGCMode LuaGC::mode = LuaGCMode::Generational;
+#else
+LuaGCMode LuaGC::mode = LuaGCMode::Incremental;
+#endif
+int LuaGC::budgetMicroseconds = 500;
+double LuaGC::heapKilobytes = 0.0;
+double LuaGC::lastIdleMicroseconds = 0.0;
+int LuaGC::lastSteps = 0;
+double LuaGC::peakStepMicroseconds = 0.0;
+uint64_t LuaGC::cycles = 0;
+
+// Debt added per incremental step, small enough that one step stays well inside the budget
+static const int STEP_KILOBYTES = 8;
+
+void LuaGC::Configure(lua_State* L, LuaGCMode newMode) {
+#if LUA_VERSION_NUM >= 504
+    mode = newMode;
+    if (mode == LuaGCMode::Generational) {
+        // Minor collection after 20% growth, major after the heap doubles
+        lua_gc(L, LUA_GCGEN, 20, 100);
+    } else {
+        // Default pause, twice the default work per step and 1 KB steps (default 8 KB),
+        // so the automatic steps that do land inside a frame are short
+        lua_gc(L, LUA_GCINC, 200, 200, 10);
+    }
+#else
+    (void)newMode;
+    mode = LuaGCMode::Incremental;
+    lua_gc(L, LUA_GCSETPAUSE, 200);
+    lua_gc(L, LUA_GCSETSTEPMUL, 200);
+#endif
+}
+
+void LuaGC::SetStepBudget(int microseconds) {
+    budgetMicroseconds = std::max(microseconds, 0);
+}
+
+void LuaGC::Step(lua_State* L) {
+    QE_PROFILE_SCOPE("LuaGC::Step");
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto deadline = start + std::chrono::microseconds(budgetMicroseconds);
+
+    int steps = 0;
+    if (budgetMicroseconds > 0) {
+        auto now = start;
+        do {
+            auto stepStart = now;
+            bool finishedCycle = lua_gc(L, LUA_GCSTEP, STEP_KILOBYTES) != 0;
+            now = Clock::now();
+            steps++;
+            peakStepMicroseconds = std::max(peakStepMicroseconds,
+                                            std::chrono::duration<double, std::micro>(now - stepStart).count());
+
+            // Don't start the next cycle from idle time, and in generational mode
+            // each step is a whole minor collection
+            if (finishedCycle) {
+                cycles++;
+                break;
+            }
+        } while (mode == LuaGCMode::Incremental && now < deadline);
+    }
+
+    lastSteps = steps;
+    lastIdleMicroseconds = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    heapKilobytes = lua_gc(L, LUA_GCCOUNT, 0) + lua_gc(L, LUA_GCCOUNTB, 0) / 1024.0;
+}
@@ -0,0 +1,189 @@
+extern "C" {
+#include <lua.h>
+}
+#include "../include/LuaCompat.h"
+#include "../include/LuaProfiler.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+bool LuaProfiler::running = false;
+
+namespace {
+
+// Instructions between clock checks in time mode
+const int TIME_CHECK_INSTRUCTIONS = 1000;
+
+// Deeper stacks are cut off at the innermost frames
+const int MAX_DEPTH = 64;
+
+LuaSampleMode sampleMode = LuaSampleMode::Instructions;
+uint64_t sampleNanoseconds = 0;
+uint64_t nextSample = 0;
+
+std::vector<LuaBindingStats> bindings;
+uint64_t sampleCount = 0;
+std::unordered_map<std::string, uint64_t> stacks;
+std::string stackKey;
+lua_Debug frames[MAX_DEPTH];
+
+void AppendFrame(std::string& key, const lua_Debug& frame) {
+    if (frame.what[0] == 'C') {
+        key += frame.name ? frame.name : "?";
+        key += " [C]";
+        return;
+    }
+    if (frame.what[0] == 'm') {
+        key += "main chunk";
+    } else {
+        key += frame.name ? frame.name : "anonymous";
+    }
+    key += " (";
+    key += frame.short_src;
+    key += ':';
+    key += std::to_string(frame.linedefined);
+    key += ')';
+}
+
+void Sample(lua_State* L, lua_Debug*) {
+    // Coroutines keep the hook they inherited after Stop, drop it on their next sample
+    if (!LuaProfiler::IsRunning()) {
+        lua_sethook(L, nullptr, 0, 0);
+        return;
+    }
+    if (sampleMode == LuaSampleMode::Time) {
+        uint64_t now = Profiler::Now();
+        if (now < nextSample) {
+            return;
+        }
+        nextSample = now + sampleNanoseconds;
+    }
+
+    int depth = 0;
+    while (depth < MAX_DEPTH && lua_getstack(L, depth, &frames[depth])) {
+        lua_getinfo(L, "Sn", &frames[depth]);
+        depth++;
+    }
+
+    // Collapsed stacks list the outermost frame first
+    stackKey.clear();
+    for (int level = depth - 1; level >= 0; level--) {
+        AppendFrame(stackKey, frames[level]);
+        if (level > 0) {
+            stackKey += ';';
+        }
+    }
+    stacks[stackKey]++;
+    sampleCount++;
+}
+
+// Stands in for a binding while profiling. Upvalues: the binding, its index in bindings.
+// A Lua error skips the bookkeeping, so calls that raise errors are not counted.
+int TimedBinding(lua_State* L) {
+    int args = lua_gettop(L);
+    lua_pushvalue(L, lua_upvalueindex(1));
+    lua_insert(L, 1);
+    uint64_t start = Profiler::Now();
+    lua_call(L, args, LUA_MULTRET);
+
+    LuaBindingStats& stats = bindings[(size_t)lua_tointeger(L, lua_upvalueindex(2))];
+    stats.nanoseconds += Profiler::Now() - start;
+    stats.calls++;
+    return lua_gettop(L);
+}
+
+} // namespace
+
+uint64_t LuaProfiler::SampleCount() {
+    return sampleCount;
+}
+
+const std::vector<LuaBindingStats>& LuaProfiler::Bindings() {
+    return bindings;
+}
+
+void LuaProfiler::AddBinding(const char* name) {
+    auto existing = std::find_if(bindings.begin(), bindings.end(), [name](const LuaBindingStats& stats) {
+        return std::strcmp(stats.name, name) == 0;
+    });
+    if (existing == bindings.end()) {
+        bindings.push_back({name, 0, 0});
+    }
+}
+
+void LuaProfiler::Start(lua_State* L, LuaSampleMode mode, int interval) {
+    interval = std::max(interval, 1);
+    sampleMode = mode;
+    if (mode == LuaSampleMode::Time) {
+        sampleNanoseconds = (uint64_t)interval * 1000;
+        nextSample = Profiler::Now() + sampleNanoseconds;
+        lua_sethook(L, Sample, LUA_MASKCOUNT, TIME_CHECK_INSTRUCTIONS);
+    } else {
+        lua_sethook(L, Sample, LUA_MASKCOUNT, interval);
+    }
+    if (running) {
+        return;
+    }
+    running = true;
+
+    // Globals a script has replaced are left alone
+    for (size_t i = 0; i < bindings.size(); i++) {
+        lua_getglobal(L, bindings[i].name);
+        if (lua_iscfunction(L, -1)) {
+            lua_pushinteger(L, (lua_Integer)i);
+            lua_pushcclosure(L, TimedBinding, 2);
+            lua_setglobal(L, bindings[i].name);
+        } else {
+            lua_pop(L, 1);
+        }
+    }
+}
+
+void LuaProfiler::Stop(lua_State* L) {
+    if (!running) {
+        return;
+    }
+    running = false;
+    lua_sethook(L, nullptr, 0, 0);
+
+    for (const LuaBindingStats& stats : bindings) {
+        lua_getglobal(L, stats.name);
+        if (lua_tocfunction(L, -1) == TimedBinding) {
+            lua_getupvalue(L, -1, 1);
+            lua_setglobal(L, stats.name);
+        }
+        lua_pop(L, 1);
+    }
+}
+
+void LuaProfiler::Clear() {
+    stacks.clear();
+    sampleCount = 0;
+    for (LuaBindingStats& stats : bindings) {
+        stats.calls = 0;
+        stats.nanoseconds = 0;
+    }
+}
+
+bool LuaProfiler::WriteCollapsedStacks(const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write Lua profile: " << path << std::endl;
+        return false;
+    }
+
+    // Sorted so two profiles of the same run diff cleanly
+    std::vector<const std::pair<const std::string, uint64_t>*> sorted;
+    sorted.reserve(stacks.size());
+    for (const auto& entry : stacks) {
+        sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) { return a->first < b->first; });
+    for (const auto* entry : sorted) {
+        file << entry->first << ' ' << entry->second << '\n';
+    }
+    return true;
+}
@@ -3,24 +3,38 @@ extern "C" {
 #include <lauxlib.h>
 #include <lualib.h>
 }
+#include "../include/LuaCompat.h"
 #include "../include/TextureLoader.h"
 #include "../include/animation.h"
 #include <vector>
-#include "../include/Sprite.h"
+#include "../include/SpriteStore.h"
 #include <GLFW/glfw3.h>
 #include "../include/LuaScripting.h"
 #include <fstream>
 #include <iostream>
 #include <filesystem>
+#include <cstring>
 #include "../include/Collision.h"
+#include "../include/Tween.h"
+#include "../include/World.h"
+#include "../include/Systems.h"
+#include "../include/Timestep.h"
+#include "../include/FrameArena.h"
+#include "../include/AllocationCounter.h"
+#include "../include/Input.h"
+#include "../include/Profiler.h"
+#include "../include/AssetManager.h"
+#include "../include/LuaSpriteProxy.h"
+#include "../include/LuaGC.h"
+#include "../include/LuaProfiler.h"
+#include "../include/CoroutineScheduler.h"
+#include "../include/ScriptSystem.h"
+#include "../include/ScriptGroups.h"
 #include <SDL3/SDL.h>
 
-// The sprite vector from your engine (accessible to Lua)
-extern std::vector<Sprite> sprites;
 
-// Optional: global project folder system
-extern std::filesystem::path assetFolder;
-extern std::string AssetPath(const std::string& relativePath);
+// Fixed simulation clock from the main loop
+extern FixedTimestep simulationTimestep;
 
 lua_State* L = nullptr;
 GLFWwindow* g_window = nullptr;
@@ -28,83 +42,118 @@ GLFWwindow* g_window = nullptr;
 void initLua() {
     L = luaL_newstate();   // Create Lua VM
     luaL_openlibs(L);      // Load Lua standard libraries
+    LuaGC::Configure(L, LuaGC::Mode());
 }
 
 void shutdownLua() {
+    CoroutineScheduler::Clear(L);
+    ScriptGroupManager::StopAll();
     lua_close(L);
 }
 
+// Look up the sprite behind the handle or proxy argument, empty if it was destroyed
+static std::optional<SpriteRef> GetSprite(lua_State* L, int arg) {
+    return world.sprites.Get(CheckSpriteHandle(L, arg));
+}
+
+// Push the handle of a dense sprite index, -1 for none
+static void PushSpriteHandle(lua_State* L, int dense) {
+    if (dense < 0) {
+        lua_pushinteger(L, -1);
+    } else {
+        lua_pushinteger(L, (lua_Integer)world.sprites.HandleAt(dense));
+    }
+}
+
 int LuaCheckCollision(lua_State* L) {
-    int indexA = (int)luaL_checkinteger(L, 1);
-    int indexB = (int)luaL_checkinteger(L, 2);
+    auto a = GetSprite(L, 1);
+    auto b = GetSprite(L, 2);
 
-    if (indexA < 0 || indexA >= (int)sprites.size() ||
-        indexB < 0 || indexB >= (int)sprites.size()) {
+    if (!a || !b) {
         lua_pushboolean(L, false);
         return 1;
         }
 
-    bool colliding = CollisionManager::CheckCollision(sprites[indexA], sprites[indexB]);
+    bool colliding = CollisionManager::CheckCollision(*a, *b);
     lua_pushboolean(L, colliding);
     return 1;
 }
 int LuaFindCollision(lua_State* L) {
-    int index = (int)luaL_checkinteger(L, 1);
+    int index = world.sprites.Find(CheckSpriteHandle(L, 1));
 
-    if (index < 0 || index >= (int)sprites.size()) {
+    if (index < 0) {
         lua_pushinteger(L, -1);
         return 1;
     }
 
-    int collision = CollisionManager::FindFirstCollision(sprites[index], sprites, index);
-    lua_pushinteger(L, collision);
+    int collision = CollisionManager::FindFirstCollision(AABB::FromStore(world.sprites, index), world.sprites, index);
+    PushSpriteHandle(L, collision);
     return 1;
 }
-int LuaFindAllCollisions(lua_State* L) {
-    int index = (int)luaL_checkinteger(L, 1);
+// Push the caller's table at 'arg' to refill, or a new one if none was passed.
+// Returns how many array entries the table held before, for TrimResultTable.
+static size_t PushResultTable(lua_State* L, int arg, size_t count) {
+    if (lua_type(L, arg) == LUA_TTABLE) {
+        lua_pushvalue(L, arg);
+        return (size_t)lua_rawlen(L, -1);
+    }
+    lua_createtable(L, (int)count, 0);
+    return 0;
+}
 
-    if (index < 0 || index >= (int)sprites.size()) {
-        lua_newtable(L);
-        return 1;
+// Clear entries past 'count' left over from a reused table's previous contents
+static void TrimResultTable(lua_State* L, size_t count, size_t previous) {
+    for (size_t i = count + 1; i <= previous; i++) {
+        lua_pushnil(L);
+        lua_rawseti(L, -2, i);
     }
+}
 
-    std::vector<int> collisions = CollisionManager::FindAllCollisions(sprites[index], sprites, index);
+// FindAllCollisions(sprite, [out]) -> table of handles. Passing the same 'out' table
+// every frame refills it in place, so the query creates no garbage.
+int LuaFindAllCollisions(lua_State* L) {
+    int index = world.sprites.Find(CheckSpriteHandle(L, 1));
 
-    lua_newtable(L);
+    std::span<int> collisions;
+    if (index >= 0) {
+        collisions = CollisionManager::FindAllCollisions(AABB::FromStore(world.sprites, index), world.sprites, frameArena, index);
+    }
+
+    size_t previous = PushResultTable(L, 2, collisions.size());
     for (size_t i = 0; i < collisions.size(); i++) {
-        lua_pushinteger(L, collisions[i]);
+        PushSpriteHandle(L, collisions[i]);
         lua_rawseti(L, -2, i + 1);
     }
+    TrimResultTable(L, collisions.size(), previous);
 
     return 1;
 }
 int LuaPointInSprite(lua_State* L) {
     float x = (float)luaL_checknumber(L, 1);
     float y = (float)luaL_checknumber(L, 2);
-    int index = (int)luaL_checkinteger(L, 3);
+    auto sprite = GetSprite(L, 3);
 
-    if (index < 0 || index >= (int)sprites.size()) {
+    if (!sprite) {
         lua_pushboolean(L, false);
         return 1;
     }
 
-    bool inside = CollisionManager::PointInSprite(x, y, sprites[index]);
+    bool inside = CollisionManager::PointInSprite(x, y, *sprite);
     lua_pushboolean(L, inside);
     return 1;
 }
 int LuaResolveCollision(lua_State* L) {
-    int indexA = (int)luaL_checkinteger(L, 1);
-    int indexB = (int)luaL_checkinteger(L, 2);
+    auto a = GetSprite(L, 1);
+    auto b = GetSprite(L, 2);
 
-    if (indexA < 0 || indexA >= (int)sprites.size() ||
-        indexB < 0 || indexB >= (int)sprites.size()) {
+    if (!a || !b) {
         lua_pushboolean(L, false);
         return 1;
         }
 
     CollisionInfo info;
-    if (CollisionManager::CheckCollision(sprites[indexA], sprites[indexB], info)) {
-        CollisionManager::ResolveCollision(sprites[indexA], sprites[indexB], info);
+    if (CollisionManager::CheckCollision(*a, *b, info)) {
+        CollisionManager::ResolveCollision(*a, *b, info);
         lua_pushboolean(L, true);
     } else {
         lua_pushboolean(L, false);
@@ -115,7 +164,7 @@ int LuaResolveCollision(lua_State* L) {
 
 
 
-// Lua function to load a texture and add it as a sprite
+// Lua function to load a texture and add it as a sprite, returns the sprite handle
 int LuaLoadTexture(lua_State* L) {
     const char* relativePath = luaL_checkstring(L, 1);
     float x = (float)luaL_optnumber(L, 2, 0.0);
@@ -135,47 +184,162 @@ int LuaLoadTexture(lua_State* L) {
         return 1; // false on failure
     }
 
-    sprites.push_back({tex, x, y, width, height});
-    lua_pushboolean(L, 1);
-    return 1; // true on success
+    SlotHandle handle = world.Spawn({tex, x, y, width, height});
+    lua_pushinteger(L, (lua_Integer)handle);
+    return 1; // sprite handle on success
+}
+
+// Remove a sprite and free its texture, O(1) and leaves every other handle valid
+bool DestroyScriptSprite(lua_State* L, SlotHandle handle) {
+    auto sprite = world.sprites.Get(handle);
+    if (!sprite) {
+        return false;
+    }
+
+    ReleaseTexture(sprite->textureID);
+    TweenManager::CancelSpriteTweens(handle);
+    ScriptSystem::Detach(L, world, handle);
+    return world.Destroy(handle);
+}
+
+int LuaDestroySprite(lua_State* L) {
+    lua_pushboolean(L, DestroyScriptSprite(L, CheckSpriteHandle(L, 1)));
+    return 1;
+}
+
+int LuaIsSpriteValid(lua_State* L) {
+    lua_pushboolean(L, GetSprite(L, 1).has_value());
+    return 1;
+}
+
+int LuaGetSpriteCount(lua_State* L) {
+    lua_pushinteger(L, (lua_Integer)world.sprites.size());
+    return 1;
+}
+
+// GetSprite(handle) -> sprite proxy with direct field access (s.x = s.x + 1), nil if the sprite is gone
+int LuaGetSpriteProxy(lua_State* L) {
+    SlotHandle handle = CheckSpriteHandle(L, 1);
+    if (!world.sprites.Contains(handle)) {
+        lua_pushnil(L);
+        return 1;
+    }
+    PushSpriteProxy(L, handle);
+    return 1;
+}
+
+// Dense array index of a sprite (0-based), -1 if the handle is stale.
+// Indices change when sprites are destroyed, so look them up again after that.
+int LuaGetSpriteIndex(lua_State* L) {
+    lua_pushinteger(L, world.sprites.Find(CheckSpriteHandle(L, 1)));
+    return 1;
+}
+
+#if USE_LUAJIT
+// Raw x, y, width and height columns plus the sprite count, wrapped as FFI cdata by SpriteArrays()
+int LuaGetSpriteColumns(lua_State* L) {
+    lua_pushlightuserdata(L, world.sprites.X());
+    lua_pushlightuserdata(L, world.sprites.Y());
+    lua_pushlightuserdata(L, world.sprites.Width());
+    lua_pushlightuserdata(L, world.sprites.Height());
+    lua_pushinteger(L, (lua_Integer)world.sprites.size());
+    return 5;
+}
+
+// SpriteArrays() returns float* views of the sprite columns, indexed 0..count-1 in
+// dense order. The pointers move when sprites are spawned or destroyed, so fetch
+// the view again after that (once per Update is enough for most scripts).
+static const char* FFI_PRELUDE = R"lua(
+local ffi = require("ffi")
+local getColumns = GetSpriteColumns
+local view = {count = 0}
+function SpriteArrays()
+    local x, y, width, height, count = getColumns()
+    view.x = ffi.cast("float*", x)
+    view.y = ffi.cast("float*", y)
+    view.width = ffi.cast("float*", width)
+    view.height = ffi.cast("float*", height)
+    view.count = count
+    return view
+end
+)lua";
+#endif
+
+// Heap allocations made by the last simulation frame, 0 unless built with ALLOCATION_COUNTER
+int LuaGetFrameAllocations(lua_State* L) {
+    lua_pushinteger(L, (lua_Integer)AllocationCounter::LastFrameAllocations());
+    return 1;
 }
 
 int LuaMoveTexture(lua_State* L) {
-    int index = (int)luaL_checkinteger(L, 1);
+    auto sprite = GetSprite(L, 1);
     float x = (float)luaL_checknumber(L, 2);
     float y = (float)luaL_checknumber(L, 3);
 
-    if (index < 0 || index >= (int)sprites.size()) {
+    if (!sprite) {
         lua_pushboolean(L, 0);
-        return 1; // false on invalid index
+        return 1; // false on invalid handle
     }
 
-    sprites[index].x = x;
-    sprites[index].y = y;
+    sprite->x = x;
+    sprite->y = y;
 
     lua_pushboolean(L, 1);
     return 1; // true on success
 }
 
+// Kept for existing scripts, same as IsKeyDown
 int LuaIsKeyPressed(lua_State* L) {
-    if (!g_window) {
-        lua_pushboolean(L, false);
-        return 1;
-    }
+    lua_pushboolean(L, InputManager::IsKeyDown((int)luaL_checkinteger(L, 1)));
+    return 1;
+}
+
+int LuaIsKeyDown(lua_State* L) {
+    lua_pushboolean(L, InputManager::IsKeyDown((int)luaL_checkinteger(L, 1)));
+    return 1;
+}
+
+int LuaWasKeyPressed(lua_State* L) {
+    lua_pushboolean(L, InputManager::WasKeyPressed((int)luaL_checkinteger(L, 1)));
+    return 1;
+}
+
+int LuaWasKeyReleased(lua_State* L) {
+    lua_pushboolean(L, InputManager::WasKeyReleased((int)luaL_checkinteger(L, 1)));
+    return 1;
+}
+
+int LuaIsMouseButtonDown(lua_State* L) {
+    lua_pushboolean(L, InputManager::IsMouseButtonDown((int)luaL_checkinteger(L, 1)));
+    return 1;
+}
+
+int LuaWasMouseButtonPressed(lua_State* L) {
+    lua_pushboolean(L, InputManager::WasMouseButtonPressed((int)luaL_checkinteger(L, 1)));
+    return 1;
+}
 
-    int key = luaL_checkinteger(L, 1);
-    lua_pushboolean(L, glfwGetKey(g_window, key) == GLFW_PRESS);
+int LuaWasMouseButtonReleased(lua_State* L) {
+    lua_pushboolean(L, InputManager::WasMouseButtonReleased((int)luaL_checkinteger(L, 1)));
     return 1;
 }
 
+int LuaGetMousePosition(lua_State* L) {
+    double x, y;
+    InputManager::GetMousePosition(x, y);
+    lua_pushnumber(L, x);
+    lua_pushnumber(L, y);
+    return 2;
+}
+
 int ChangeTexture(lua_State* L) {
-    int index = (int)luaL_checkinteger(L, 1);
+    auto sprite = GetSprite(L, 1);
     const char* relativePath = luaL_checkstring(L, 2);
 
-    // Validate sprite index
-    if (index < 0 || index >= (int)sprites.size()) {
+    // Validate sprite handle
+    if (!sprite) {
         lua_pushboolean(L, 0);
-        return 1; // false on invalid index
+        return 1; // false on invalid handle
     }
 
     std::string fullPath = relativePath;
@@ -190,10 +354,10 @@ int ChangeTexture(lua_State* L) {
     }
 
     // Delete old texture (optional, prevents memory leaks)
-    glDeleteTextures(1, &sprites[index].textureID);
+    ReleaseTexture(sprite->textureID);
 
 
-    sprites[index].textureID = newTex;
+    sprite->textureID = newTex;
 
     lua_pushboolean(L, 1);
     return 1;
@@ -239,6 +403,12 @@ int LuaUpdateAnimation(lua_State* L) {
     return 0;
 }
 
+int LuaUpdateAllAnimations(lua_State* L) {
+    float deltaTime = (float)luaL_checknumber(L, 1);
+    AnimationManager::UpdateAllAnimations(deltaTime);
+    return 0;
+}
+
 int LuaPlayAnimation(lua_State* L) {
     int animIndex = (int)luaL_checkinteger(L, 1);
     AnimationManager::PlayAnimation(animIndex);
@@ -278,10 +448,10 @@ int LuaIsAnimationFinished(lua_State* L) {
 }
 
 int LuaSetSpriteAnimation(lua_State* L) {
-    int spriteIndex = (int)luaL_checkinteger(L, 1);
+    auto sprite = GetSprite(L, 1);
     int animIndex = (int)luaL_checkinteger(L, 2);
 
-    if (spriteIndex < 0 || spriteIndex >= (int)sprites.size()) {
+    if (!sprite) {
         lua_pushboolean(L, false);
         return 1;
     }
@@ -292,85 +462,593 @@ int LuaSetSpriteAnimation(lua_State* L) {
         return 1;
     }
 
-    sprites[spriteIndex].textureID = textureID;
+    sprite->textureID = textureID;
     lua_pushboolean(L, true);
     return 1;
 }
 // Change sprite texture directly using GLuint
 int LuaSetSpriteTexture(lua_State* L) {
-    int spriteIndex = (int)luaL_checkinteger(L, 1);
+    auto sprite = GetSprite(L, 1);
     GLuint texID = (GLuint)luaL_checkinteger(L, 2);
 
-    if (spriteIndex < 0 || spriteIndex >= (int)sprites.size()) {
+    if (!sprite) {
         lua_pushboolean(L, false);
         return 1;
     }
 
     // Delete old texture if needed
-    glDeleteTextures(1, &sprites[spriteIndex].textureID);
-    sprites[spriteIndex].textureID = texID;
+    ReleaseTexture(sprite->textureID);
+    sprite->textureID = texID;
 
     lua_pushboolean(L, true);
     return 1;
 }
+// GetSpritePosition(sprite) -> x, y (nil if the sprite is gone)
 int LuaGetSpritePosition(lua_State* L) {
-    int index = (int)luaL_checkinteger(L, 1);
-    if (index < 0 || index >= (int)sprites.size()) {
+    auto sprite = GetSprite(L, 1);
+    if (!sprite) {
         lua_pushnil(L);
         return 1;
     }
-    lua_newtable(L);
-    lua_pushnumber(L, sprites[index].x);
-    lua_rawseti(L, -2, 1);
-    lua_pushnumber(L, sprites[index].y);
-    lua_rawseti(L, -2, 2);
-    return 1;
+    lua_pushnumber(L, sprite->x);
+    lua_pushnumber(L, sprite->y);
+    return 2;
 }
 int LuaSetSpriteSize(lua_State* L) {
-    int index = (int)luaL_checkinteger(L, 1);
+    auto sprite = GetSprite(L, 1);
     float width = (float)luaL_checknumber(L, 2);
     float height = (float)luaL_checknumber(L, 3);
 
-    if (index < 0 || index >= (int)sprites.size()) {
+    if (!sprite) {
+        lua_pushboolean(L, false);
+        return 1;
+    }
+
+    sprite->width = width;
+    sprite->height = height;
+    lua_pushboolean(L, true);
+    return 1;
+}
+
+int LuaSetSpriteColor(lua_State* L) {
+    auto sprite = GetSprite(L, 1);
+    float r = (float)luaL_checknumber(L, 2);
+    float g = (float)luaL_checknumber(L, 3);
+    float b = (float)luaL_checknumber(L, 4);
+    float a = (float)luaL_optnumber(L, 5, 1.0);
+
+    if (!sprite) {
+        lua_pushboolean(L, false);
+        return 1;
+    }
+
+    sprite->r = r;
+    sprite->g = g;
+    sprite->b = b;
+    sprite->a = a;
+    lua_pushboolean(L, true);
+    return 1;
+}
+
+// Length of the array table at 'arg', raises a Lua error for anything else
+static size_t CheckArray(lua_State* L, int arg) {
+    luaL_checktype(L, arg, LUA_TTABLE);
+    return (size_t)lua_rawlen(L, arg);
+}
+
+// Shared loop of the batch setters: sprite handles[i] gets first[i] and second[i].
+// Stale handles are skipped, returns how many sprites were updated.
+static int SetColumnPairs(lua_State* L, SpriteColumn firstColumn, SpriteColumn secondColumn) {
+    size_t count = CheckArray(L, 1);
+    luaL_argcheck(L, CheckArray(L, 2) >= count, 2, "fewer values than handles");
+    luaL_argcheck(L, CheckArray(L, 3) >= count, 3, "fewer values than handles");
+
+    float* first = world.sprites.Column(firstColumn);
+    float* second = world.sprites.Column(secondColumn);
+    int updated = 0;
+    for (size_t i = 1; i <= count; i++) {
+        lua_rawgeti(L, 1, i);
+        lua_rawgeti(L, 2, i);
+        lua_rawgeti(L, 3, i);
+        int index = world.sprites.Find(ToSpriteHandle(L, -3));
+        if (index >= 0) {
+            first[index] = (float)lua_tonumber(L, -2);
+            second[index] = (float)lua_tonumber(L, -1);
+            updated++;
+        }
+        lua_pop(L, 3);
+    }
+
+    lua_pushinteger(L, updated);
+    return 1;
+}
+
+// MoveTextures(handles, xs, ys) -> sprites moved
+int LuaMoveTextures(lua_State* L) {
+    return SetColumnPairs(L, COLUMN_X, COLUMN_Y);
+}
+
+// SetSpriteSizes(handles, widths, heights) -> sprites resized
+int LuaSetSpriteSizes(lua_State* L) {
+    return SetColumnPairs(L, COLUMN_WIDTH, COLUMN_HEIGHT);
+}
+
+// ApplyOffset(handles, offsets) with a flat {dx1, dy1, dx2, dy2, ...} array, or
+// ApplyOffset(handles, dx, dy) to move every sprite by the same amount -> sprites moved
+int LuaApplyOffset(lua_State* L) {
+    size_t count = CheckArray(L, 1);
+    float* x = world.sprites.X();
+    float* y = world.sprites.Y();
+    int updated = 0;
+
+    if (lua_type(L, 2) == LUA_TTABLE) {
+        luaL_argcheck(L, CheckArray(L, 2) >= count * 2, 2, "offsets needs two values per handle");
+        for (size_t i = 1; i <= count; i++) {
+            lua_rawgeti(L, 1, i);
+            lua_rawgeti(L, 2, i * 2 - 1);
+            lua_rawgeti(L, 2, i * 2);
+            int index = world.sprites.Find(ToSpriteHandle(L, -3));
+            if (index >= 0) {
+                x[index] += (float)lua_tonumber(L, -2);
+                y[index] += (float)lua_tonumber(L, -1);
+                updated++;
+            }
+            lua_pop(L, 3);
+        }
+    } else {
+        float dx = (float)luaL_checknumber(L, 2);
+        float dy = (float)luaL_checknumber(L, 3);
+        for (size_t i = 1; i <= count; i++) {
+            lua_rawgeti(L, 1, i);
+            int index = world.sprites.Find(ToSpriteHandle(L, -1));
+            if (index >= 0) {
+                x[index] += dx;
+                y[index] += dy;
+                updated++;
+            }
+            lua_pop(L, 1);
+        }
+    }
+
+    lua_pushinteger(L, updated);
+    return 1;
+}
+
+// Read the {x=, y=, width=, height=, r=, g=, b=, a=} table at 'arg' into a tween target
+static TweenTarget CheckTweenTarget(lua_State* L, int arg) {
+    static const char* fields[TWEEN_PROPERTY_COUNT] = {"x", "y", "width", "height", "r", "g", "b", "a"};
+
+    luaL_checktype(L, arg, LUA_TTABLE);
+    TweenTarget target;
+    for (int p = 0; p < TWEEN_PROPERTY_COUNT; p++) {
+        lua_getfield(L, arg, fields[p]);
+        if (lua_type(L, -1) == LUA_TNUMBER) {
+            target.Set(static_cast<TweenProperty>(p), (float)lua_tonumber(L, -1));
+        }
+        lua_pop(L, 1);
+    }
+    return target;
+}
+
+// TweenTo(sprite, props, duration, [ease], [delay]) -> tween id
+int LuaTweenTo(lua_State* L) {
+    SlotHandle handle = CheckSpriteHandle(L, 1);
+    TweenTarget target = CheckTweenTarget(L, 2);
+    float duration = (float)luaL_checknumber(L, 3);
+    EaseType ease = EaseFromName(luaL_optstring(L, 4, "linear"));
+    float delay = (float)luaL_optnumber(L, 5, 0.0);
+
+    if (!world.sprites.Contains(handle)) {
+        lua_pushinteger(L, 0);
+        return 1;
+    }
+
+    lua_pushinteger(L, TweenManager::TweenTo(handle, target, duration, ease, delay));
+    return 1;
+}
+
+// TweenAfter(previousTween, sprite, props, duration, [ease], [delay]) -> tween id
+int LuaTweenAfter(lua_State* L) {
+    int after = (int)luaL_checkinteger(L, 1);
+    SlotHandle handle = CheckSpriteHandle(L, 2);
+    TweenTarget target = CheckTweenTarget(L, 3);
+    float duration = (float)luaL_checknumber(L, 4);
+    EaseType ease = EaseFromName(luaL_optstring(L, 5, "linear"));
+    float delay = (float)luaL_optnumber(L, 6, 0.0);
+
+    if (!world.sprites.Contains(handle)) {
+        lua_pushinteger(L, 0);
+        return 1;
+    }
+
+    lua_pushinteger(L, TweenManager::TweenTo(handle, target, duration, ease, delay, after));
+    return 1;
+}
+
+int LuaCancelTween(lua_State* L) {
+    int tweenId = (int)luaL_checkinteger(L, 1);
+    TweenManager::CancelTween(tweenId);
+    return 0;
+}
+
+int LuaCancelSpriteTweens(lua_State* L) {
+    SlotHandle handle = CheckSpriteHandle(L, 1);
+    TweenManager::CancelSpriteTweens(handle);
+    return 0;
+}
+
+int LuaIsTweenActive(lua_State* L) {
+    int tweenId = (int)luaL_checkinteger(L, 1);
+    lua_pushboolean(L, TweenManager::IsTweenActive(tweenId));
+    return 1;
+}
+
+int LuaSetTickRate(lua_State* L) {
+    float tickRate = (float)luaL_checknumber(L, 1);
+    simulationTimestep.SetTickRate(tickRate);
+    return 0;
+}
+
+int LuaGetTickRate(lua_State* L) {
+    lua_pushnumber(L, simulationTimestep.GetTickRate());
+    return 1;
+}
+
+int LuaSetMaxCatchUpSteps(lua_State* L) {
+    int maxSteps = (int)luaL_checkinteger(L, 1);
+    simulationTimestep.SetMaxStepsPerFrame(maxSteps);
+    return 0;
+}
+
+// SetGCMode("incremental" | "generational"), generational needs Lua 5.4
+int LuaSetGCMode(lua_State* L) {
+    static const char* const modes[] = {"incremental", "generational", nullptr};
+    int mode = luaL_checkoption(L, 1, nullptr, modes);
+    LuaGC::Configure(L, mode == 1 ? LuaGCMode::Generational : LuaGCMode::Incremental);
+    return 0;
+}
+
+// SetGCBudget(microseconds), idle time per frame spent on GC steps
+int LuaSetGCBudget(lua_State* L) {
+    LuaGC::SetStepBudget((int)luaL_checkinteger(L, 1));
+    return 0;
+}
+
+// GetGCStats() -> heap KB, last idle GC time in microseconds, peak step microseconds, cycles
+int LuaGetGCStats(lua_State* L) {
+    lua_pushnumber(L, LuaGC::HeapKilobytes());
+    lua_pushnumber(L, LuaGC::LastIdleMicroseconds());
+    lua_pushnumber(L, LuaGC::PeakStepMicroseconds());
+    lua_pushinteger(L, (lua_Integer)LuaGC::Cycles());
+    return 4;
+}
+
+// AttachScript(sprite, class) gives the sprite its own instance of a script class,
+// replacing any script it had. Returns the instance table.
+int LuaAttachScript(lua_State* L) {
+    SlotHandle handle = CheckSpriteHandle(L, 1);
+    luaL_checktype(L, 2, LUA_TTABLE);
+    if (!world.sprites.Contains(handle)) {
+        lua_pushnil(L);
+        return 1;
+    }
+    ScriptSystem::Attach(L, world, handle, 2);
+    return 1;
+}
+
+// DetachScript(sprite) runs OnDestroy and drops the script
+int LuaDetachScript(lua_State* L) {
+    SlotHandle handle = CheckSpriteHandle(L, 1);
+    lua_pushboolean(L, ScriptSystem::Detach(L, world, handle));
+    return 1;
+}
+
+// StartScriptGroup(name, script) runs scripts/<script> in its own VM on the job workers
+int LuaStartScriptGroup(lua_State* L) {
+    const char* name = luaL_checkstring(L, 1);
+    const char* script = luaL_checkstring(L, 2);
+    luaL_argcheck(L, std::strcmp(name, "main") != 0, 1, "'main' is the main VM");
+    lua_pushboolean(L, ScriptGroupManager::Start(name, (assetFolder / "scripts" / script).string()));
+    return 1;
+}
+
+int LuaStopScriptGroup(lua_State* L) {
+    lua_pushboolean(L, ScriptGroupManager::Stop(luaL_checkstring(L, 1)));
+    return 1;
+}
+
+// PostMessage(group, channel, value), false if there is no such group
+int LuaPostMessage(lua_State* L) {
+    const char* to = luaL_checkstring(L, 1);
+    const char* channel = luaL_checkstring(L, 2);
+    ScriptValue value = CheckScriptValue(L, 3);
+    lua_pushboolean(L, ScriptGroupManager::Post(to, channel, std::move(value)));
+    return 1;
+}
+
+// StartCoroutine(fn, ...) runs fn(...) on a scheduled coroutine until its first wait, returns its handle
+int LuaStartCoroutine(lua_State* L) {
+    luaL_checktype(L, 1, LUA_TFUNCTION);
+    SlotHandle handle = CoroutineScheduler::Start(L, lua_gettop(L) - 1);
+    lua_pushinteger(L, (lua_Integer)handle);
+    return 1;
+}
+
+int LuaStopCoroutine(lua_State* L) {
+    lua_pushboolean(L, CoroutineScheduler::Stop(L, (SlotHandle)luaL_checkinteger(L, 1)));
+    return 1;
+}
+
+int LuaIsCoroutineAlive(lua_State* L) {
+    lua_pushboolean(L, CoroutineScheduler::IsAlive((SlotHandle)luaL_checkinteger(L, 1)));
+    return 1;
+}
+
+// Signal(name) wakes every coroutine in WaitUntil(name) on the next tick, returns how many
+int LuaSignal(lua_State* L) {
+    lua_pushinteger(L, CoroutineScheduler::Signal(luaL_checkstring(L, 1)));
+    return 1;
+}
+
+static int NotScheduled(lua_State* L, const char* name) {
+    return luaL_error(L, "%s must be called from a coroutine started with StartCoroutine", name);
+}
+
+// Wait(seconds) of simulation time
+int LuaWait(lua_State* L) {
+    double seconds = luaL_checknumber(L, 1);
+    if (!CoroutineScheduler::WaitSeconds(L, seconds)) {
+        return NotScheduled(L, "Wait");
+    }
+    return lua_yield(L, 0);
+}
+
+// WaitFrames(n) simulation ticks, at least one
+int LuaWaitFrames(lua_State* L) {
+    int ticks = (int)luaL_optinteger(L, 1, 1);
+    if (!CoroutineScheduler::WaitTicks(L, ticks)) {
+        return NotScheduled(L, "WaitFrames");
+    }
+    return lua_yield(L, 0);
+}
+
+// WaitUntil(signal) sleeps until Signal(signal)
+int LuaWaitUntil(lua_State* L) {
+    const char* signal = luaL_checkstring(L, 1);
+    if (!CoroutineScheduler::WaitSignal(L, signal)) {
+        return NotScheduled(L, "WaitUntil");
+    }
+    return lua_yield(L, 0);
+}
+
+// SetVelocity(sprite, vx, vy), pixels per second, moved by MovementSystem
+int LuaSetVelocity(lua_State* L) {
+    SlotHandle handle = CheckSpriteHandle(L, 1);
+    float vx = (float)luaL_checknumber(L, 2);
+    float vy = (float)luaL_checknumber(L, 3);
+
+    if (!world.sprites.Contains(handle)) {
+        lua_pushboolean(L, false);
+        return 1;
+    }
+
+    world.components.Add<Velocity>(handle, {vx, vy});
+    lua_pushboolean(L, true);
+    return 1;
+}
+
+int LuaSetLayer(lua_State* L) {
+    SlotHandle handle = CheckSpriteHandle(L, 1);
+    int layer = (int)luaL_checkinteger(L, 2);
+
+    if (!world.sprites.Contains(handle)) {
+        lua_pushboolean(L, false);
+        return 1;
+    }
+
+    world.components.Add<Layer>(handle, {layer});
+    lua_pushboolean(L, true);
+    return 1;
+}
+
+// SetCollider(sprite, [solid]) adds the sprite to CollisionSystem, solid colliders get pushed apart
+int LuaSetCollider(lua_State* L) {
+    SlotHandle handle = CheckSpriteHandle(L, 1);
+    bool solid = lua_isnoneornil(L, 2) ? true : lua_toboolean(L, 2);
+
+    if (!world.sprites.Contains(handle)) {
+        lua_pushboolean(L, false);
+        return 1;
+    }
+
+    world.components.Add<Collider>(handle, {solid});
+    lua_pushboolean(L, true);
+    return 1;
+}
+
+int LuaRemoveCollider(lua_State* L) {
+    SlotHandle handle = CheckSpriteHandle(L, 1);
+    lua_pushboolean(L, world.components.Remove<Collider>(handle));
+    return 1;
+}
+
+// AttachAnimation(sprite, anim, [advance]) makes the sprite's texture follow the animation
+int LuaAttachAnimation(lua_State* L) {
+    SlotHandle handle = CheckSpriteHandle(L, 1);
+    int animIndex = (int)luaL_checkinteger(L, 2);
+    bool advance = lua_isnoneornil(L, 3) ? true : lua_toboolean(L, 3);
+
+    if (!world.sprites.Contains(handle)) {
         lua_pushboolean(L, false);
         return 1;
     }
 
-    sprites[index].width = width;
-    sprites[index].height = height;
+    world.components.Add<AnimationComponent>(handle, {animIndex, advance});
     lua_pushboolean(L, true);
     return 1;
 }
 
+int LuaDetachAnimation(lua_State* L) {
+    SlotHandle handle = CheckSpriteHandle(L, 1);
+    lua_pushboolean(L, world.components.Remove<AnimationComponent>(handle));
+    return 1;
+}
 
 // ... existing code ...
 
+int LuaWriteProfileTrace(lua_State* L) {
+    const char* path = luaL_checkstring(L, 1);
+    lua_pushboolean(L, Profiler::Enabled() && Profiler::WriteChromeTrace(path));
+    return 1;
+}
+
+// StartLuaProfiler(["instructions" | "time"], interval), sampling every 'interval'
+// instructions (default 1000) or microseconds (default 1000) of the main Lua thread
+int LuaStartLuaProfiler(lua_State* L) {
+    static const char* const modes[] = {"instructions", "time", nullptr};
+    LuaSampleMode mode = luaL_checkoption(L, 1, "instructions", modes) == 1 ? LuaSampleMode::Time
+                                                                            : LuaSampleMode::Instructions;
+    int interval = (int)luaL_optinteger(L, 2, 1000);
+    LuaProfiler::Start(::L, mode, interval);
+    return 0;
+}
+
+int LuaStopLuaProfiler(lua_State* L) {
+    LuaProfiler::Stop(::L);
+    return 0;
+}
+
+// WriteLuaProfile(path), collapsed stacks for flamegraph.pl or speedscope
+int LuaWriteLuaProfile(lua_State* L) {
+    const char* path = luaL_checkstring(L, 1);
+    lua_pushboolean(L, LuaProfiler::WriteCollapsedStacks(path));
+    return 1;
+}
+
+#if ENABLE_PROFILER
+// Bindings run inside a profile event named after their Lua global. Timed by hand
+// rather than with ProfileScope because a Lua error longjmps out of the call.
+static int ProfiledBinding(lua_State* L) {
+    lua_CFunction function = lua_tocfunction(L, lua_upvalueindex(1));
+    const char* name = static_cast<const char*>(lua_touserdata(L, lua_upvalueindex(2)));
+    uint64_t start = Profiler::Now();
+    int results = function(L);
+    Profiler::Record(name, start, Profiler::Now());
+    return results;
+}
+#endif
+
+static void RegisterBinding(const char* name, lua_CFunction function) {
+    LuaProfiler::AddBinding(name);
+#if ENABLE_PROFILER
+    lua_pushcfunction(L, function);
+    lua_pushlightuserdata(L, const_cast<char*>(name));
+    lua_pushcclosure(L, ProfiledBinding, 2);
+    lua_setglobal(L, name);
+#else
+    lua_register(L, name, function);
+#endif
+}
+
 void registerLuaFunctions() {
-    lua_register(L, "GetSpritePosition", LuaGetSpritePosition);
-    lua_register(L, "LoadTexture", LuaLoadTexture);
-    lua_register(L, "MoveTexture", LuaMoveTexture);
-    lua_register(L, "IsKeyPressed", LuaIsKeyPressed);
-    lua_register(L, "ChangeTexture", ChangeTexture);
-    lua_register(L, "SetSpriteTexture", LuaSetSpriteTexture);
-    lua_register(L, "SetSpriteSize", LuaSetSpriteSize);
-
-    lua_register(L, "CheckCollision", LuaCheckCollision);
-    lua_register(L, "FindCollision", LuaFindCollision);
-    lua_register(L, "FindAllCollisions", LuaFindAllCollisions);
-    lua_register(L, "PointInSprite", LuaPointInSprite);
-    lua_register(L, "ResolveCollision", LuaResolveCollision);
+    RegisterSpriteProxy(L);
+    RegisterBinding("GetSpritePosition", LuaGetSpritePosition);
+    RegisterBinding("LoadTexture", LuaLoadTexture);
+    RegisterBinding("MoveTexture", LuaMoveTexture);
+    RegisterBinding("DestroySprite", LuaDestroySprite);
+    RegisterBinding("IsSpriteValid", LuaIsSpriteValid);
+    RegisterBinding("GetSpriteCount", LuaGetSpriteCount);
+    RegisterBinding("GetSpriteIndex", LuaGetSpriteIndex);
+    RegisterBinding("GetSprite", LuaGetSpriteProxy);
+    RegisterBinding("GetFrameAllocations", LuaGetFrameAllocations);
+    RegisterBinding("WriteProfileTrace", LuaWriteProfileTrace);
+    RegisterBinding("StartLuaProfiler", LuaStartLuaProfiler);
+    RegisterBinding("StopLuaProfiler", LuaStopLuaProfiler);
+    RegisterBinding("WriteLuaProfile", LuaWriteLuaProfile);
+    RegisterBinding("IsKeyPressed", LuaIsKeyPressed);
+    RegisterBinding("IsKeyDown", LuaIsKeyDown);
+    RegisterBinding("WasKeyPressed", LuaWasKeyPressed);
+    RegisterBinding("WasKeyReleased", LuaWasKeyReleased);
+    RegisterBinding("IsMouseButtonDown", LuaIsMouseButtonDown);
+    RegisterBinding("WasMouseButtonPressed", LuaWasMouseButtonPressed);
+    RegisterBinding("WasMouseButtonReleased", LuaWasMouseButtonReleased);
+    RegisterBinding("GetMousePosition", LuaGetMousePosition);
+    RegisterBinding("ChangeTexture", ChangeTexture);
+    RegisterBinding("SetSpriteTexture", LuaSetSpriteTexture);
+    RegisterBinding("SetSpriteSize", LuaSetSpriteSize);
+    RegisterBinding("SetSpriteColor", LuaSetSpriteColor);
+    RegisterBinding("MoveTextures", LuaMoveTextures);
+    RegisterBinding("SetSpriteSizes", LuaSetSpriteSizes);
+    RegisterBinding("ApplyOffset", LuaApplyOffset);
+
+    RegisterBinding("CheckCollision", LuaCheckCollision);
+    RegisterBinding("FindCollision", LuaFindCollision);
+    RegisterBinding("FindAllCollisions", LuaFindAllCollisions);
+    RegisterBinding("PointInSprite", LuaPointInSprite);
+    RegisterBinding("ResolveCollision", LuaResolveCollision);
 
     // Animation functions
-    lua_register(L, "CreateAnimation", LuaCreateAnimation);
-    lua_register(L, "AddAnimationFrame", LuaAddAnimationFrame);
-    lua_register(L, "UpdateAnimation", LuaUpdateAnimation);
-    lua_register(L, "PlayAnimation", LuaPlayAnimation);
-    lua_register(L, "PauseAnimation", LuaPauseAnimation);
-    lua_register(L, "StopAnimation", LuaStopAnimation);
-    lua_register(L, "ResetAnimation", LuaResetAnimation);
-    lua_register(L, "GetAnimationTexture", LuaGetAnimationTexture);
-    lua_register(L, "IsAnimationFinished", LuaIsAnimationFinished);
-    lua_register(L, "SetSpriteAnimation", LuaSetSpriteAnimation);
+    RegisterBinding("CreateAnimation", LuaCreateAnimation);
+    RegisterBinding("AddAnimationFrame", LuaAddAnimationFrame);
+    RegisterBinding("UpdateAnimation", LuaUpdateAnimation);
+    RegisterBinding("UpdateAllAnimations", LuaUpdateAllAnimations);
+    RegisterBinding("PlayAnimation", LuaPlayAnimation);
+    RegisterBinding("PauseAnimation", LuaPauseAnimation);
+    RegisterBinding("StopAnimation", LuaStopAnimation);
+    RegisterBinding("ResetAnimation", LuaResetAnimation);
+    RegisterBinding("GetAnimationTexture", LuaGetAnimationTexture);
+    RegisterBinding("IsAnimationFinished", LuaIsAnimationFinished);
+    RegisterBinding("SetSpriteAnimation", LuaSetSpriteAnimation);
+
+    // Tween functions
+    RegisterBinding("TweenTo", LuaTweenTo);
+    RegisterBinding("TweenAfter", LuaTweenAfter);
+    RegisterBinding("CancelTween", LuaCancelTween);
+    RegisterBinding("CancelSpriteTweens", LuaCancelSpriteTweens);
+    RegisterBinding("IsTweenActive", LuaIsTweenActive);
+
+    // Simulation clock
+    RegisterBinding("SetTickRate", LuaSetTickRate);
+    RegisterBinding("GetTickRate", LuaGetTickRate);
+    RegisterBinding("SetMaxCatchUpSteps", LuaSetMaxCatchUpSteps);
+
+    // Garbage collector
+    RegisterBinding("SetGCMode", LuaSetGCMode);
+    RegisterBinding("SetGCBudget", LuaSetGCBudget);
+    RegisterBinding("GetGCStats", LuaGetGCStats);
+
+    // Coroutines. The waits yield, so they are registered bare: a wrapper would
+    // leave its C frame between the yield and the coroutine.
+    RegisterBinding("StartCoroutine", LuaStartCoroutine);
+    RegisterBinding("StopCoroutine", LuaStopCoroutine);
+    RegisterBinding("IsCoroutineAlive", LuaIsCoroutineAlive);
+    RegisterBinding("Signal", LuaSignal);
+    lua_register(L, "Wait", LuaWait);
+    lua_register(L, "WaitFrames", LuaWaitFrames);
+    lua_register(L, "WaitUntil", LuaWaitUntil);
+
+    // Script groups
+    RegisterBinding("StartScriptGroup", LuaStartScriptGroup);
+    RegisterBinding("StopScriptGroup", LuaStopScriptGroup);
+    RegisterBinding("PostMessage", LuaPostMessage);
+
+    // Components
+    RegisterBinding("SetVelocity", LuaSetVelocity);
+    RegisterBinding("SetLayer", LuaSetLayer);
+    RegisterBinding("SetCollider", LuaSetCollider);
+    RegisterBinding("RemoveCollider", LuaRemoveCollider);
+    RegisterBinding("AttachAnimation", LuaAttachAnimation);
+    RegisterBinding("DetachAnimation", LuaDetachAnimation);
+    RegisterBinding("AttachScript", LuaAttachScript);
+    RegisterBinding("DetachScript", LuaDetachScript);
+
+#if USE_LUAJIT
+    RegisterBinding("GetSpriteColumns", LuaGetSpriteColumns);
+    if (luaL_dostring(L, FFI_PRELUDE) != LUA_OK) {
+        std::cerr << "Failed to set up LuaJIT sprite arrays: " << lua_tostring(L, -1) << std::endl;
+        lua_pop(L, 1);
+    }
+#endif
 }
 
 bool RunLuaFile(const std::string& filepath) {
@@ -0,0 +1,175 @@
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+#include "../include/LuaCompat.h"
+#include "../include/LuaSpriteProxy.h"
+#include "../include/World.h"
+
+namespace {
+
+const char* SPRITE_METATABLE = "QEngine.Sprite";
+
+// The first fields line up with the sprite store columns
+enum SpriteField {
+    FIELD_TEXTURE = SPRITE_COLUMN_COUNT,
+    FIELD_HANDLE,
+    FIELD_VALID,
+    FIELD_COUNT
+};
+
+const char* FIELD_NAMES[FIELD_COUNT] = {
+    "x", "y", "width", "height", "r", "g", "b", "a", "texture", "handle", "valid"
+};
+
+// Field name strings as interned by this VM. Short strings are interned, so a key
+// equal to a field name is the very same string object and one pointer comparison
+// per field replaces hashing the key.
+struct FieldNames {
+    const char* names[FIELD_COUNT];
+};
+
+int FindField(lua_State* L, int arg) {
+    if (lua_type(L, arg) != LUA_TSTRING) {
+        return -1;
+    }
+    const FieldNames* fields = static_cast<const FieldNames*>(lua_touserdata(L, lua_upvalueindex(1)));
+    const char* key = lua_tostring(L, arg);
+    for (int field = 0; field < FIELD_COUNT; field++) {
+        if (fields->names[field] == key) {
+            return field;
+        }
+    }
+    return -1;
+}
+
+int UnknownField(lua_State* L) {
+    const char* key = lua_type(L, 2) == LUA_TSTRING ? lua_tostring(L, 2) : lua_typename(L, lua_type(L, 2));
+    return luaL_error(L, "sprite has no field '%s'", key);
+}
+
+SlotHandle ProxyHandle(lua_State* L) {
+    return *static_cast<SlotHandle*>(lua_touserdata(L, 1));
+}
+
+int SpriteIndex(lua_State* L) {
+    int field = FindField(L, 2);
+    if (field < 0) {
+        return UnknownField(L);
+    }
+
+    SlotHandle handle = ProxyHandle(L);
+    if (field == FIELD_HANDLE) {
+        lua_pushinteger(L, (lua_Integer)handle);
+        return 1;
+    }
+
+    int index = world.sprites.Find(handle);
+    if (field == FIELD_VALID) {
+        lua_pushboolean(L, index >= 0);
+    } else if (index < 0) {
+        lua_pushnil(L);
+    } else if (field == FIELD_TEXTURE) {
+        lua_pushinteger(L, world.sprites.TextureIDs()[index]);
+    } else {
+        lua_pushnumber(L, world.sprites.Column(static_cast<SpriteColumn>(field))[index]);
+    }
+    return 1;
+}
+
+// Plain stores: assigning texture does not release the old one, unlike SetSpriteTexture
+int SpriteNewIndex(lua_State* L) {
+    int field = FindField(L, 2);
+    if (field < 0) {
+        return UnknownField(L);
+    }
+    if (field == FIELD_HANDLE || field == FIELD_VALID) {
+        return luaL_error(L, "sprite field '%s' is read-only", FIELD_NAMES[field]);
+    }
+
+    int index = world.sprites.Find(ProxyHandle(L));
+    if (field == FIELD_TEXTURE) {
+        GLuint texture = (GLuint)luaL_checkinteger(L, 3);
+        if (index >= 0) {
+            world.sprites.TextureIDs()[index] = texture;
+        }
+    } else {
+        float value = (float)luaL_checknumber(L, 3);
+        if (index >= 0) {
+            world.sprites.Column(static_cast<SpriteColumn>(field))[index] = value;
+        }
+    }
+    return 0;
+}
+
+int SpriteEquals(lua_State* L) {
+    lua_pushboolean(L, ToSpriteHandle(L, 1) == ToSpriteHandle(L, 2));
+    return 1;
+}
+
+int SpriteToString(lua_State* L) {
+    SlotHandle handle = ProxyHandle(L);
+    lua_pushfstring(L, "Sprite(%d:%d)", (int)HandleSlot(handle), (int)HandleGeneration(handle));
+    return 1;
+}
+
+} // namespace
+
+void RegisterSpriteProxy(lua_State* L) {
+    luaL_newmetatable(L, SPRITE_METATABLE);
+
+    // Anchor the field name strings in the metatable so their interned copies stay put
+    lua_createtable(L, FIELD_COUNT, 0);
+    FieldNames* fields = static_cast<FieldNames*>(lua_newuserdata(L, sizeof(FieldNames)));
+    for (int field = 0; field < FIELD_COUNT; field++) {
+        lua_pushstring(L, FIELD_NAMES[field]);
+        fields->names[field] = lua_tostring(L, -1);
+        lua_rawseti(L, -3, field + 1);
+    }
+    // Stack: metatable, names, fields
+    lua_pushvalue(L, -1);
+    lua_pushcclosure(L, SpriteIndex, 1);
+    lua_setfield(L, -4, "__index");
+    lua_pushcclosure(L, SpriteNewIndex, 1);
+    lua_setfield(L, -3, "__newindex");
+    lua_setfield(L, -2, "__fieldnames");
+
+    lua_pushcfunction(L, SpriteEquals);
+    lua_setfield(L, -2, "__eq");
+    lua_pushcfunction(L, SpriteToString);
+    lua_setfield(L, -2, "__tostring");
+    lua_pop(L, 1);
+}
+
+void PushSpriteProxy(lua_State* L, SlotHandle handle) {
+    SlotHandle* proxy = static_cast<SlotHandle*>(lua_newuserdata(L, sizeof(SlotHandle)));
+    *proxy = handle;
+    luaL_setmetatable(L, SPRITE_METATABLE);
+}
+
+SlotHandle ToSpriteHandle(lua_State* L, int arg) {
+    if (lua_type(L, arg) == LUA_TNUMBER) {
+        lua_Integer handle = 0;
+        return LuaToInteger(L, arg, &handle) ? (SlotHandle)handle : INVALID_HANDLE;
+    }
+    if (SlotHandle* proxy = static_cast<SlotHandle*>(luaL_testudata(L, arg, SPRITE_METATABLE))) {
+        return *proxy;
+    }
+    return INVALID_HANDLE;
+}
+
+SlotHandle CheckSpriteHandle(lua_State* L, int arg) {
+    // A float must not truncate to some other sprite's handle
+    if (lua_type(L, arg) == LUA_TNUMBER) {
+        lua_Integer handle = 0;
+        if (!LuaToInteger(L, arg, &handle)) {
+            luaL_argerror(L, arg, "number has no integer representation");
+        }
+        return (SlotHandle)handle;
+    }
+    SlotHandle* proxy = static_cast<SlotHandle*>(luaL_testudata(L, arg, SPRITE_METATABLE));
+    if (!proxy) {
+        luaL_argerror(L, arg, "sprite handle or sprite expected");
+    }
+    return *proxy;
+}
@@ -0,0 +1,185 @@
+#include "../include/OffscreenContext.h"
+#include <iostream>
+#include <vector>
+#include <cstdio>
+
+#if OFFSCREEN_RENDERING
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <png.h>
+
+bool OffscreenContext::Create(int targetWidth, int targetHeight) {
+    Destroy();
+
+    // Surfaceless platform needs no display server, fall back to the default display
+    EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay) {
+        eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (eglDisplay == EGL_NO_DISPLAY) {
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    EGLint major, minor;
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor)) {
+        std::cerr << "Failed to initialize EGL" << std::endl;
+        return false;
+    }
+    display = eglDisplay;
+
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(eglDisplay, configAttributes, &config, 1, &configCount) || configCount == 0) {
+        // Surfaceless displays may expose no pbuffer configs, the context never uses a surface anyway
+        const EGLint anyConfig[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+        if (!eglChooseConfig(eglDisplay, anyConfig, &config, 1, &configCount) || configCount == 0) {
+            std::cerr << "No EGL config with desktop OpenGL support" << std::endl;
+            Destroy();
+            return false;
+        }
+    }
+
+    eglBindAPI(EGL_OPENGL_API);
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+    if (eglContext == EGL_NO_CONTEXT) {
+        std::cerr << "Failed to create EGL OpenGL 3.3 context" << std::endl;
+        Destroy();
+        return false;
+    }
+    context = eglContext;
+
+    if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext)) {
+        std::cerr << "EGL surfaceless contexts are not supported" << std::endl;
+        Destroy();
+        return false;
+    }
+
+    // glewInit goes through GLX, load entry points from the current context instead
+    glewExperimental = GL_TRUE;
+    if (glewContextInit() != GLEW_OK) {
+        std::cerr << "Failed to initialize GLEW" << std::endl;
+        Destroy();
+        return false;
+    }
+    glGetError();
+
+    width = targetWidth;
+    height = targetHeight;
+
+    glGenTextures(1, &colorTexture);
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Offscreen framebuffer is incomplete" << std::endl;
+        Destroy();
+        return false;
+    }
+
+    Bind();
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    std::cout << "Offscreen EGL " << major << "." << minor << " context, OpenGL "
+              << glGetString(GL_VERSION) << " on " << glGetString(GL_RENDERER) << std::endl;
+    return true;
+}
+
+void OffscreenContext::Destroy() {
+    if (context) {
+        if (framebuffer) {
+            glDeleteFramebuffers(1, &framebuffer);
+        }
+        if (colorTexture) {
+            glDeleteTextures(1, &colorTexture);
+        }
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+    }
+    if (display) {
+        eglTerminate(display);
+    }
+    framebuffer = 0;
+    colorTexture = 0;
+    context = nullptr;
+    display = nullptr;
+}
+
+void OffscreenContext::Bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+}
+
+bool OffscreenContext::SavePNG(const std::string& path) const {
+    std::vector<unsigned char> pixels((size_t)width * height * 4);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    png_infop info = png ? png_create_info_struct(png) : nullptr;
+    if (!png || !info || setjmp(png_jmpbuf(png))) {
+        std::cerr << "Failed to write PNG " << path << std::endl;
+        png_destroy_write_struct(&png, &info);
+        std::fclose(file);
+        return false;
+    }
+
+    png_init_io(png, file);
+    png_set_IHDR(png, info, width, height, 8, PNG_COLOR_TYPE_RGBA, PNG_INTERLACE_NONE,
+                 PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(png, info);
+
+    // GL rows start at the bottom, PNG rows at the top
+    for (int row = height - 1; row >= 0; row--) {
+        png_write_row(png, pixels.data() + (size_t)row * width * 4);
+    }
+    png_write_end(png, nullptr);
+    png_destroy_write_struct(&png, &info);
+    std::fclose(file);
+    return true;
+}
+
+#else
+
+bool OffscreenContext::Create(int, int) {
+    std::cerr << "Offscreen rendering is not available in this build (OFFSCREEN_RENDERING=0)" << std::endl;
+    return false;
+}
+
+void OffscreenContext::Destroy() {
+}
+
+void OffscreenContext::Bind() const {
+}
+
+bool OffscreenContext::SavePNG(const std::string&) const {
+    return false;
+}
+
+#endif
@@ -0,0 +1,44 @@
+#include "../include/PerformanceStats.h"
+
+float PerformanceStats::frameTimes[HISTORY] = {};
+int PerformanceStats::frameTimeNext = 0;
+int PerformanceStats::frameTimeCount = 0;
+uint32_t PerformanceStats::drawCalls = 0;
+uint32_t PerformanceStats::textureBinds = 0;
+uint32_t PerformanceStats::lastDrawCalls = 0;
+uint32_t PerformanceStats::lastTextureBinds = 0;
+double PerformanceStats::luaPending = 0.0;
+double PerformanceStats::luaMilliseconds = 0.0;
+
+void PerformanceStats::RecordFrameTime(float milliseconds) {
+    frameTimes[frameTimeNext] = milliseconds;
+    frameTimeNext = (frameTimeNext + 1) % HISTORY;
+    if (frameTimeCount < HISTORY) {
+        frameTimeCount++;
+    }
+}
+
+void PerformanceStats::BeginRender() {
+    // Keep the finished frame's counts for display and start counting the next one
+    lastDrawCalls = drawCalls;
+    lastTextureBinds = textureBinds;
+    drawCalls = 0;
+    textureBinds = 0;
+}
+
+void PerformanceStats::EndSimulationFrame() {
+    luaMilliseconds = luaPending;
+    luaPending = 0.0;
+}
+
+float PerformanceStats::AverageFrameTime() {
+    if (frameTimeCount == 0) {
+        return 0.0f;
+    }
+    // Until the buffer fills the recorded frames are the first frameTimeCount entries
+    float total = 0.0f;
+    for (int i = 0; i < frameTimeCount; i++) {
+        total += frameTimes[i];
+    }
+    return total / frameTimeCount;
+}
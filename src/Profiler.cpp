@@ -0,0 +1,139 @@
+#include "../include/Profiler.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct ProfileEvent {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+};
+
+// Written only by its owning thread, head is published with release so a reader
+// sees complete events up to it
+struct ThreadBuffer {
+    std::unique_ptr<ProfileEvent[]> events{new ProfileEvent[Profiler::EVENTS_PER_THREAD]};
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> tail{0};     // first event still wanted, moved by Clear()
+    const char* name = nullptr;
+    uint32_t threadId = 0;
+};
+
+// Buffers outlive their threads so job workers that exited still show up in the trace
+std::mutex buffersMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+thread_local ThreadBuffer* threadBuffer = nullptr;
+ThreadBuffer* gpuBuffer = nullptr;
+
+const auto clockStart = std::chrono::steady_clock::now();
+
+ThreadBuffer* CreateBuffer() {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffers.push_back(std::make_unique<ThreadBuffer>());
+    buffers.back()->threadId = static_cast<uint32_t>(buffers.size());
+    return buffers.back().get();
+}
+
+ThreadBuffer& GetThreadBuffer() {
+    if (!threadBuffer) {
+        threadBuffer = CreateBuffer();
+    }
+    return *threadBuffer;
+}
+
+void Push(ThreadBuffer& buffer, const char* name, uint64_t start, uint64_t end) {
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head & (Profiler::EVENTS_PER_THREAD - 1)] = {name, start, end};
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void WriteEscaped(std::ostream& out, const char* text) {
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+}
+
+} // namespace
+
+uint64_t Profiler::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - clockStart).count());
+}
+
+void Profiler::Record(const char* name, uint64_t start, uint64_t end) {
+    Push(GetThreadBuffer(), name, start, end);
+}
+
+void Profiler::RecordGpu(const char* name, uint64_t start, uint64_t end) {
+    if (!gpuBuffer) {
+        gpuBuffer = CreateBuffer();
+        gpuBuffer->name = "GPU";
+    }
+    Push(*gpuBuffer, name, start, end);
+}
+
+void Profiler::SetThreadName(const char* name) {
+    GetThreadBuffer().name = name;
+}
+
+void Profiler::Clear() {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (auto& buffer : buffers) {
+        buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to open trace file: " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    size_t written = 0;
+
+    for (auto& buffer : buffers) {
+        if (buffer->name) {
+            out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                << buffer->threadId << ",\"args\":{\"name\":\"";
+            WriteEscaped(out, buffer->name);
+            out << "\"}}";
+            first = false;
+        }
+
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+        if (head - tail > EVENTS_PER_THREAD) {
+            tail = head - EVENTS_PER_THREAD;
+        }
+
+        for (uint64_t i = tail; i < head; i++) {
+            const ProfileEvent& event = buffer->events[i & (EVENTS_PER_THREAD - 1)];
+            out << (first ? "" : ",") << "\n{\"name\":\"";
+            WriteEscaped(out, event.name);
+            out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << event.start / 1000.0
+                << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+            first = false;
+            written++;
+        }
+    }
+
+    out << "\n]}\n";
+    std::cout << "Wrote " << written << " profile events to " << path << std::endl;
+    return true;
+}
@@ -0,0 +1,351 @@
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+#include <lualib.h>
+}
+#include "../include/LuaCompat.h"
+#include "../include/ScriptGroups.h"
+#include "../include/LuaScripting.h"
+#include "../include/LuaSpriteProxy.h"
+#include "../include/LuaGC.h"
+#include "../include/World.h"
+#include "../include/JobSystem.h"
+#include "../include/Profiler.h"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+const char* MAIN_VM = "main";
+
+enum class CommandType {
+    Move,
+    Resize,
+    Color,
+    Velocity,
+    Destroy
+};
+
+struct ScriptCommand {
+    CommandType type;
+    SlotHandle handle;
+    float values[4];
+};
+
+struct ScriptMessage {
+    std::string from;
+    std::string to;
+    std::string channel;
+    ScriptValue value;
+};
+
+struct ScriptGroup {
+    std::string name;
+    lua_State* L = nullptr;
+    std::vector<ScriptCommand> commands;    // applied at the sync point
+    std::vector<ScriptMessage> inbox;       // delivered at the start of its next Update
+    std::vector<ScriptMessage> outbox;      // routed at the sync point
+};
+
+// Heap allocated so the group pointer bound to its Lua functions stays put
+std::vector<std::unique_ptr<ScriptGroup>> groups;
+
+// Drained from every group before anything is applied, since applying runs main VM
+// callbacks that may start or stop groups
+std::vector<ScriptCommand> pendingCommands;
+std::vector<ScriptMessage> pendingMessages;
+
+ScriptGroup* FindGroup(const std::string& name) {
+    for (auto& group : groups) {
+        if (group->name == name) {
+            return group.get();
+        }
+    }
+    return nullptr;
+}
+
+void PushValue(lua_State* L, const ScriptValue& value) {
+    if (const bool* boolean = std::get_if<bool>(&value)) {
+        lua_pushboolean(L, *boolean);
+    } else if (const double* number = std::get_if<double>(&value)) {
+        lua_pushnumber(L, *number);
+    } else if (const std::string* string = std::get_if<std::string>(&value)) {
+        lua_pushlstring(L, string->data(), string->size());
+    } else {
+        lua_pushnil(L);
+    }
+}
+
+// Hand the message to the VM's OnMessage, VMs without one drop it
+void Deliver(lua_State* L, const ScriptMessage& message) {
+    lua_getglobal(L, "OnMessage");
+    if (lua_type(L, -1) != LUA_TFUNCTION) {
+        lua_pop(L, 1);
+        return;
+    }
+    lua_pushstring(L, message.from.c_str());
+    lua_pushstring(L, message.channel.c_str());
+    PushValue(L, message.value);
+    if (lua_pcall(L, 3, 0, 0) != LUA_OK) {
+        std::cerr << "Lua OnMessage error in " << message.to << ": " << lua_tostring(L, -1) << std::endl;
+        lua_pop(L, 1);
+    }
+}
+
+// Group side functions, upvalue 1 is the ScriptGroup
+
+ScriptGroup& Self(lua_State* L) {
+    return *static_cast<ScriptGroup*>(lua_touserdata(L, lua_upvalueindex(1)));
+}
+
+// Queue a command taking 'count' numbers after the sprite, true if the sprite exists now
+int Queue(lua_State* L, CommandType type, int count) {
+    ScriptCommand command{type, CheckSpriteHandle(L, 1), {0.0f, 0.0f, 0.0f, 1.0f}};
+    for (int i = 0; i < count; i++) {
+        command.values[i] = (float)luaL_checknumber(L, i + 2);
+    }
+    if (type == CommandType::Color) {
+        command.values[3] = (float)luaL_optnumber(L, 5, 1.0);
+    }
+    Self(L).commands.push_back(command);
+    lua_pushboolean(L, world.sprites.Contains(command.handle));
+    return 1;
+}
+
+int GroupMoveTexture(lua_State* L) {
+    return Queue(L, CommandType::Move, 2);
+}
+
+int GroupSetSpriteSize(lua_State* L) {
+    return Queue(L, CommandType::Resize, 2);
+}
+
+int GroupSetSpriteColor(lua_State* L) {
+    return Queue(L, CommandType::Color, 3);
+}
+
+int GroupSetVelocity(lua_State* L) {
+    return Queue(L, CommandType::Velocity, 2);
+}
+
+int GroupDestroySprite(lua_State* L) {
+    return Queue(L, CommandType::Destroy, 0);
+}
+
+int GroupGetSpritePosition(lua_State* L) {
+    auto sprite = world.sprites.Get(CheckSpriteHandle(L, 1));
+    if (!sprite) {
+        lua_pushnil(L);
+        return 1;
+    }
+    lua_pushnumber(L, sprite->x);
+    lua_pushnumber(L, sprite->y);
+    return 2;
+}
+
+int GroupIsSpriteValid(lua_State* L) {
+    lua_pushboolean(L, world.sprites.Contains(CheckSpriteHandle(L, 1)));
+    return 1;
+}
+
+int GroupGetSpriteCount(lua_State* L) {
+    lua_pushinteger(L, (lua_Integer)world.sprites.size());
+    return 1;
+}
+
+// PostMessage(to, channel, value), to is a group name or "main"
+int GroupPostMessage(lua_State* L) {
+    const char* to = luaL_checkstring(L, 1);
+    const char* channel = luaL_checkstring(L, 2);
+    ScriptValue value = CheckScriptValue(L, 3);
+    ScriptGroup& self = Self(L);
+    self.outbox.push_back({self.name, to, channel, std::move(value)});
+    return 0;
+}
+
+int GroupGetName(lua_State* L) {
+    lua_pushstring(L, Self(L).name.c_str());
+    return 1;
+}
+
+const luaL_Reg GROUP_FUNCTIONS[] = {
+    {"GetSpritePosition", GroupGetSpritePosition},
+    {"IsSpriteValid", GroupIsSpriteValid},
+    {"GetSpriteCount", GroupGetSpriteCount},
+    {"MoveTexture", GroupMoveTexture},
+    {"SetSpriteSize", GroupSetSpriteSize},
+    {"SetSpriteColor", GroupSetSpriteColor},
+    {"SetVelocity", GroupSetVelocity},
+    {"DestroySprite", GroupDestroySprite},
+    {"PostMessage", GroupPostMessage},
+    {"GetGroupName", GroupGetName},
+    {nullptr, nullptr}
+};
+
+// Runs on a job worker, touching only the group's own VM and queues
+void RunGroup(ScriptGroup& group, float deltaTime) {
+    QE_PROFILE_SCOPE("ScriptGroup");
+    for (const ScriptMessage& message : group.inbox) {
+        Deliver(group.L, message);
+    }
+    group.inbox.clear();
+
+    lua_getglobal(group.L, "Update");
+    if (lua_type(group.L, -1) != LUA_TFUNCTION) {
+        lua_pop(group.L, 1);
+        return;
+    }
+    lua_pushnumber(group.L, deltaTime);
+    if (lua_pcall(group.L, 1, 0, 0) != LUA_OK) {
+        std::cerr << "Lua Update error in group " << group.name << ": " << lua_tostring(group.L, -1) << std::endl;
+        lua_pop(group.L, 1);
+    }
+}
+
+void Apply(lua_State* mainState, const ScriptCommand& command) {
+    if (command.type == CommandType::Destroy) {
+        DestroyScriptSprite(mainState, command.handle);
+        return;
+    }
+    auto sprite = world.sprites.Get(command.handle);
+    if (!sprite) {
+        return;
+    }
+    const float* values = command.values;
+    switch (command.type) {
+    case CommandType::Move:
+        sprite->x = values[0];
+        sprite->y = values[1];
+        break;
+    case CommandType::Resize:
+        sprite->width = values[0];
+        sprite->height = values[1];
+        break;
+    case CommandType::Color:
+        sprite->r = values[0];
+        sprite->g = values[1];
+        sprite->b = values[2];
+        sprite->a = values[3];
+        break;
+    case CommandType::Velocity:
+        world.components.Add<Velocity>(command.handle, {values[0], values[1]});
+        break;
+    case CommandType::Destroy:
+        break;
+    }
+}
+
+} // namespace
+
+ScriptValue CheckScriptValue(lua_State* L, int arg) {
+    switch (lua_type(L, arg)) {
+    case LUA_TNONE:
+    case LUA_TNIL:
+        return {};
+    case LUA_TBOOLEAN:
+        return lua_toboolean(L, arg) != 0;
+    case LUA_TNUMBER:
+        return lua_tonumber(L, arg);
+    case LUA_TSTRING: {
+        size_t length = 0;
+        const char* string = lua_tolstring(L, arg, &length);
+        return std::string(string, length);
+    }
+    default:
+        luaL_argerror(L, arg, "nil, boolean, number or string expected");
+        return {};
+    }
+}
+
+bool ScriptGroupManager::Start(const std::string& name, const std::string& scriptPath) {
+    Stop(name);
+
+    auto group = std::make_unique<ScriptGroup>();
+    group->name = name;
+    group->L = luaL_newstate();
+    luaL_openlibs(group->L);
+    LuaGC::Configure(group->L, LuaGC::Mode());
+    for (const luaL_Reg* function = GROUP_FUNCTIONS; function->name; function++) {
+        lua_pushlightuserdata(group->L, group.get());
+        lua_pushcclosure(group->L, function->func, 1);
+        lua_setglobal(group->L, function->name);
+    }
+
+    if (luaL_dofile(group->L, scriptPath.c_str()) != LUA_OK) {
+        std::cerr << "Failed to start script group " << name << ": " << lua_tostring(group->L, -1) << std::endl;
+        lua_close(group->L);
+        return false;
+    }
+    groups.push_back(std::move(group));
+    return true;
+}
+
+bool ScriptGroupManager::Stop(const std::string& name) {
+    for (auto it = groups.begin(); it != groups.end(); ++it) {
+        if ((*it)->name == name) {
+            lua_close((*it)->L);
+            groups.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ScriptGroupManager::StopAll() {
+    for (auto& group : groups) {
+        lua_close(group->L);
+    }
+    groups.clear();
+}
+
+bool ScriptGroupManager::Post(const std::string& to, const std::string& channel, ScriptValue value) {
+    ScriptGroup* group = FindGroup(to);
+    if (!group) {
+        return false;
+    }
+    group->inbox.push_back({MAIN_VM, to, channel, std::move(value)});
+    return true;
+}
+
+void ScriptGroupManager::Update(lua_State* mainState, float deltaTime) {
+    if (groups.empty()) {
+        return;
+    }
+    QE_PROFILE_FUNCTION();
+
+    std::unique_ptr<ScriptGroup>* list = groups.data();
+    JobSystem::ParallelFor(groups.size(), 1, [list, deltaTime](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            RunGroup(*list[i], deltaTime);
+        }
+    });
+
+    // Sync point, back to one thread
+    for (auto& group : groups) {
+        pendingCommands.insert(pendingCommands.end(), group->commands.begin(), group->commands.end());
+        group->commands.clear();
+        for (ScriptMessage& message : group->outbox) {
+            pendingMessages.push_back(std::move(message));
+        }
+        group->outbox.clear();
+    }
+
+    for (const ScriptCommand& command : pendingCommands) {
+        Apply(mainState, command);
+    }
+    pendingCommands.clear();
+
+    for (ScriptMessage& message : pendingMessages) {
+        if (message.to == MAIN_VM) {
+            Deliver(mainState, message);
+        } else if (ScriptGroup* group = FindGroup(message.to)) {
+            group->inbox.push_back(std::move(message));
+        }
+    }
+    pendingMessages.clear();
+}
+
+size_t ScriptGroupManager::Count() {
+    return groups.size();
+}
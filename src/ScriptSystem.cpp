@@ -0,0 +1,145 @@
+extern "C" {
+#include <lua.h>
+#include <lauxlib.h>
+}
+#include "../include/LuaCompat.h"
+#include "../include/ScriptSystem.h"
+#include "../include/LuaSpriteProxy.h"
+#include "../include/Systems.h"
+#include "../include/FrameArena.h"
+#include "../include/Profiler.h"
+#include <iostream>
+
+namespace {
+
+// Registry reference to the instance's callback, LUA_NOREF if it has none
+int ResolveCallback(lua_State* L, int instance, const char* name) {
+    lua_getfield(L, instance, name);
+    if (lua_type(L, -1) != LUA_TFUNCTION) {
+        lua_pop(L, 1);
+        return LUA_NOREF;
+    }
+    return luaL_ref(L, LUA_REGISTRYINDEX);
+}
+
+void PushCallback(lua_State* L, int callback, int instance) {
+    lua_rawgeti(L, LUA_REGISTRYINDEX, callback);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, instance);
+}
+
+// Call the pushed callback with self and 'nargs' arguments, a script error only skips that call
+void Invoke(lua_State* L, int nargs, const char* callback) {
+    if (lua_pcall(L, nargs + 1, 0, 0) != LUA_OK) {
+        std::cerr << "Lua " << callback << " error: " << lua_tostring(L, -1) << std::endl;
+        lua_pop(L, 1);
+    }
+}
+
+void Release(lua_State* L, const ScriptComponent& script) {
+    luaL_unref(L, LUA_REGISTRYINDEX, script.onUpdate);
+    luaL_unref(L, LUA_REGISTRYINDEX, script.onCollision);
+    luaL_unref(L, LUA_REGISTRYINDEX, script.onDestroy);
+    luaL_unref(L, LUA_REGISTRYINDEX, script.instance);
+}
+
+void DispatchCollision(lua_State* L, ComponentPool<ScriptComponent>& scripts, Entity self, Entity other) {
+    ScriptComponent* script = scripts.Get(self);
+    if (script && script->onCollision != LUA_NOREF) {
+        PushCallback(L, script->onCollision, script->instance);
+        lua_pushinteger(L, (lua_Integer)other);
+        Invoke(L, 1, "OnCollision");
+    }
+}
+
+} // namespace
+
+void ScriptSystem::Attach(lua_State* L, World& world, Entity entity, int classIndex) {
+    if (classIndex < 0) {
+        classIndex = lua_gettop(L) + classIndex + 1;
+    }
+    Detach(L, world, entity);
+
+    lua_newtable(L);
+    PushSpriteProxy(L, entity);
+    lua_setfield(L, -2, "sprite");
+    lua_pushinteger(L, (lua_Integer)entity);
+    lua_setfield(L, -2, "handle");
+
+    // Instance methods come from the class
+    lua_newtable(L);
+    lua_pushvalue(L, classIndex);
+    lua_setfield(L, -2, "__index");
+    lua_setmetatable(L, -2);
+
+    int instance = lua_gettop(L);
+    ScriptComponent script;
+    script.onUpdate = ResolveCallback(L, instance, "OnUpdate");
+    script.onCollision = ResolveCallback(L, instance, "OnCollision");
+    script.onDestroy = ResolveCallback(L, instance, "OnDestroy");
+    lua_pushvalue(L, instance);
+    script.instance = luaL_ref(L, LUA_REGISTRYINDEX);
+    world.components.Add<ScriptComponent>(entity, script);
+
+    lua_getfield(L, instance, "OnStart");
+    if (lua_type(L, -1) == LUA_TFUNCTION) {
+        lua_pushvalue(L, instance);
+        Invoke(L, 0, "OnStart");
+    } else {
+        lua_pop(L, 1);
+    }
+}
+
+bool ScriptSystem::Detach(lua_State* L, World& world, Entity entity) {
+    ScriptComponent* found = world.components.Get<ScriptComponent>(entity);
+    if (!found) {
+        return false;
+    }
+    // Remove first so OnDestroy can't detach or dispatch to it again
+    ScriptComponent script = *found;
+    world.components.Remove<ScriptComponent>(entity);
+
+    if (script.onDestroy != LUA_NOREF) {
+        PushCallback(L, script.onDestroy, script.instance);
+        Invoke(L, 0, "OnDestroy");
+    }
+    Release(L, script);
+    return true;
+}
+
+void ScriptSystem::Update(lua_State* L, World& world, float deltaTime) {
+    QE_PROFILE_SCOPE("ScriptSystem::Update");
+    ComponentPool<ScriptComponent>& scripts = world.components.Pool<ScriptComponent>();
+    if (scripts.Size() == 0) {
+        return;
+    }
+
+    // Callbacks may attach or detach scripts, so walk a copy of the entity list
+    ArenaVector<Entity> entities(frameArena, scripts.Size());
+    for (size_t i = 0; i < scripts.Size(); i++) {
+        if (scripts.At(i).onUpdate != LUA_NOREF) {
+            entities.push_back(scripts.Entities()[i]);
+        }
+    }
+
+    for (Entity entity : entities) {
+        ScriptComponent* script = scripts.Get(entity);
+        if (!script) {
+            continue;
+        }
+        PushCallback(L, script->onUpdate, script->instance);
+        lua_pushnumber(L, deltaTime);
+        Invoke(L, 1, "OnUpdate");
+    }
+}
+
+void ScriptSystem::DispatchCollisions(lua_State* L, World& world) {
+    QE_PROFILE_SCOPE("ScriptSystem::DispatchCollisions");
+    ComponentPool<ScriptComponent>& scripts = world.components.Pool<ScriptComponent>();
+    if (scripts.Size() == 0) {
+        return;
+    }
+    for (const auto& [a, b] : CollisionSystem::Contacts()) {
+        DispatchCollision(L, scripts, a, b);
+        DispatchCollision(L, scripts, b, a);
+    }
+}
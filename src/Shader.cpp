@@ -1,10 +1,12 @@
 // Shader.cpp
 #include "../include/Shader.h"
+#include "../include/Profiler.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
 Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
+    QE_PROFILE_SCOPE("Shader::Shader");
     std::string vCode = loadFile(vertexPath);
     std::string fCode = loadFile(fragmentPath);
 
@@ -0,0 +1,97 @@
+#include "../include/SpriteStore.h"
+
+SlotHandle SpriteStore::Insert(const Sprite& sprite) {
+    SlotHandle handle = index.Create();
+    textureIDs.push_back(sprite.textureID);
+    columns[COLUMN_X].push_back(sprite.x);
+    columns[COLUMN_Y].push_back(sprite.y);
+    columns[COLUMN_WIDTH].push_back(sprite.width);
+    columns[COLUMN_HEIGHT].push_back(sprite.height);
+    columns[COLUMN_R].push_back(sprite.r);
+    columns[COLUMN_G].push_back(sprite.g);
+    columns[COLUMN_B].push_back(sprite.b);
+    columns[COLUMN_A].push_back(sprite.a);
+    return handle;
+}
+
+bool SpriteStore::Remove(SlotHandle handle) {
+    uint32_t removed;
+    if (!index.Remove(handle, removed)) {
+        return false;
+    }
+
+    // Swap-remove in every column, mirroring the slot index
+    size_t last = textureIDs.size() - 1;
+    textureIDs[removed] = textureIDs[last];
+    textureIDs.pop_back();
+    for (auto& column : columns) {
+        column[removed] = column[last];
+        column.pop_back();
+    }
+    return true;
+}
+
+void SpriteStore::Clear() {
+    index.Clear();
+    textureIDs.clear();
+    for (auto& column : columns) {
+        column.clear();
+    }
+}
+
+std::optional<SpriteRef> SpriteStore::Get(SlotHandle handle) {
+    int dense = index.Find(handle);
+    if (dense < 0) {
+        return std::nullopt;
+    }
+    return (*this)[dense];
+}
+
+SpriteRef SpriteStore::operator[](size_t dense) {
+    return {
+        textureIDs[dense],
+        columns[COLUMN_X][dense],
+        columns[COLUMN_Y][dense],
+        columns[COLUMN_WIDTH][dense],
+        columns[COLUMN_HEIGHT][dense],
+        columns[COLUMN_R][dense],
+        columns[COLUMN_G][dense],
+        columns[COLUMN_B][dense],
+        columns[COLUMN_A][dense]
+    };
+}
+
+Sprite SpriteStore::Load(size_t dense) const {
+    return {
+        textureIDs[dense],
+        columns[COLUMN_X][dense],
+        columns[COLUMN_Y][dense],
+        columns[COLUMN_WIDTH][dense],
+        columns[COLUMN_HEIGHT][dense],
+        columns[COLUMN_R][dense],
+        columns[COLUMN_G][dense],
+        columns[COLUMN_B][dense],
+        columns[COLUMN_A][dense]
+    };
+}
+
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t SpriteStore::Checksum() const {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size(); i++) {
+        SlotHandle handle = HandleAt(i);
+        hash = HashBytes(hash, &handle, sizeof(handle));
+    }
+    for (int c = 0; c < SPRITE_COLUMN_COUNT; c++) {
+        hash = HashBytes(hash, columns[c].data(), columns[c].size() * sizeof(float));
+    }
+    return hash;
+}
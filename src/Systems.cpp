@@ -0,0 +1,140 @@
+#include "../include/Systems.h"
+#include "../include/animation.h"
+#include "../include/FrameArena.h"
+#include "../include/Profiler.h"
+#include <algorithm>
+
+std::vector<std::pair<Entity, Entity>> CollisionSystem::contacts;
+std::vector<int> RenderSystem::visible;
+size_t RenderSystem::culled = 0;
+
+void MovementSystem::Update(World& world, float deltaTime) {
+    QE_PROFILE_SCOPE("MovementSystem::Update");
+    SpriteStore& sprites = world.sprites;
+    float* x = sprites.X();
+    float* y = sprites.Y();
+
+    world.components.Each<Velocity>([&](Entity entity, Velocity& velocity) {
+        int index = sprites.Find(entity);
+        if (index < 0) {
+            return;
+        }
+        x[index] += velocity.x * deltaTime;
+        y[index] += velocity.y * deltaTime;
+    });
+}
+
+void AnimationSystem::Update(World& world, float deltaTime) {
+    QE_PROFILE_SCOPE("AnimationSystem::Update");
+    SpriteStore& sprites = world.sprites;
+    GLuint* textureIDs = sprites.TextureIDs();
+
+    // Several entities may share one animation, advance each at most once per tick
+    size_t animationCount = AnimationManager::animations.size();
+    unsigned char* advanced = frameArena.AllocateArray<unsigned char>(animationCount);
+    std::fill(advanced, advanced + animationCount, 0);
+
+    world.components.Each<AnimationComponent>([&](Entity entity, AnimationComponent& anim) {
+        int index = sprites.Find(entity);
+        if (index < 0 || anim.animIndex < 0 || anim.animIndex >= (int)animationCount) {
+            return;
+        }
+        if (anim.advance && !advanced[anim.animIndex]) {
+            AnimationManager::UpdateAnimation(anim.animIndex, deltaTime);
+            advanced[anim.animIndex] = 1;
+        }
+
+        GLuint texture = AnimationManager::GetAnimationTexture(anim.animIndex);
+        if (texture) {
+            textureIDs[index] = texture;
+        }
+    });
+}
+
+namespace {
+
+// A collider's bounds at the start of the collision pass
+struct ColliderBounds {
+    AABB bounds;
+    Entity entity;
+    int dense;
+    uint32_t order;     // position in the Collider pool, fixes which side of a pair is 'a'
+    bool solid;
+};
+
+} // namespace
+
+void CollisionSystem::Update(World& world) {
+    QE_PROFILE_SCOPE("CollisionSystem::Update");
+    SpriteStore& sprites = world.sprites;
+    contacts.clear();
+
+    // Gather the colliders' bounds once
+    size_t colliderCount = world.components.Pool<Collider>().Size();
+    ArenaVector<ColliderBounds> colliders(frameArena, colliderCount);
+    world.components.Each<Collider>([&](Entity entity, Collider& collider) {
+        int index = sprites.Find(entity);
+        if (index >= 0) {
+            colliders.push_back({AABB::FromStore(sprites, index), entity, index,
+                                 static_cast<uint32_t>(colliders.size()), collider.solid});
+        }
+    });
+
+    // Sort and sweep on x: ordered by left edge, a collider can only overlap the ones after
+    // it that start before its right edge. Ties keep pool order so contacts are deterministic.
+    std::sort(colliders.begin(), colliders.end(), [](const ColliderBounds& a, const ColliderBounds& b) {
+        return a.bounds.x != b.bounds.x ? a.bounds.x < b.bounds.x : a.order < b.order;
+    });
+
+    for (size_t p = 0; p < colliders.size(); p++) {
+        const ColliderBounds& first = colliders[p];
+        float right = first.bounds.x + first.bounds.width;
+        for (size_t q = p + 1; q < colliders.size() && colliders[q].bounds.x < right; q++) {
+            if (!first.bounds.Intersects(colliders[q].bounds)) {
+                continue;
+            }
+            const ColliderBounds& i = first.order < colliders[q].order ? first : colliders[q];
+            const ColliderBounds& j = first.order < colliders[q].order ? colliders[q] : first;
+
+            // Earlier pushes this pass may have moved either sprite, test where they are now
+            AABB a = AABB::FromStore(sprites, i.dense);
+            AABB b = AABB::FromStore(sprites, j.dense);
+            if (!a.Intersects(b)) {
+                continue;
+            }
+
+            contacts.emplace_back(i.entity, j.entity);
+            if (i.solid && j.solid) {
+                CollisionInfo info(i.dense, j.dense,
+                                   std::min((a.x + a.width) - b.x, (b.x + b.width) - a.x),
+                                   std::min((a.y + a.height) - b.y, (b.y + b.height) - a.y));
+                CollisionManager::ResolveCollision(sprites[i.dense], sprites[j.dense], info);
+            }
+        }
+    }
+}
+
+void RenderSystem::BuildRenderList(World& world, const SpriteStore& previous, float alpha,
+                                   const AABB& region, std::vector<Sprite>& out) {
+    QE_PROFILE_SCOPE("RenderSystem::BuildRenderList");
+    SpriteStore& sprites = world.sprites;
+    CollisionManager::FindVisible(region, sprites, visible);
+    culled = sprites.size() - visible.size();
+
+    // Order by layer only when some entity has one. Visible indices come out ascending, so
+    // sorting on (layer, index) keeps store order within a layer without stable_sort's heap buffer
+    ComponentPool<Layer>& layers = world.components.Pool<Layer>();
+    if (layers.Size() > 0) {
+        std::pair<int, int>* keyed = frameArena.AllocateArray<std::pair<int, int>>(visible.size());
+        for (size_t k = 0; k < visible.size(); k++) {
+            Layer* layer = layers.Get(sprites.HandleAt(visible[k]));
+            keyed[k] = {layer ? layer->value : 0, visible[k]};
+        }
+        std::sort(keyed, keyed + visible.size());
+        for (size_t k = 0; k < visible.size(); k++) {
+            visible[k] = keyed[k].second;
+        }
+    }
+
+    InterpolateSprites(previous, sprites, alpha, visible, out);
+}
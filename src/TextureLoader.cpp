@@ -1,6 +1,10 @@
 #include "../include/TextureLoader.h"
+#include "../include/Profiler.h"
 #include <SDL3_image/SDL_image.h>
 #include <iostream>
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
 #include <GL/glew.h> // or glad
 
 // For stb_image
@@ -16,9 +20,88 @@ GLenum get_gl_format(int channels) {
     }
 }
 
+static bool headlessTextures = false;
+static GLuint nextHeadlessTexture = 1;
+
+// Bytes per live texture, for the memory estimate
+static std::unordered_map<GLuint, size_t> textureBytes;
+static size_t textureMemory = 0;
+
+// Released names waiting for DeleteReleasedTextures. Released on the simulation thread and
+// deleted on the main thread, the pipeline's Wait orders the two.
+static std::vector<GLuint> releasedTextures;
+
+static void TrackTexture(GLuint textureID, int width, int height) {
+    // Drivers store RGB as RGBA, a full mip chain adds a third
+    size_t bytes = (size_t)width * height * 4;
+    bytes += bytes / 3;
+    textureBytes[textureID] = bytes;
+    textureMemory += bytes;
+}
+
+size_t GetTextureMemory() {
+    return textureMemory;
+}
+
+void SetHeadlessTextures(bool headless) {
+    headlessTextures = headless;
+}
+
+bool IsHeadlessTextures() {
+    return headlessTextures;
+}
+
+// Validate the file the same way a real load would fail, without decoding pixels
+static GLuint LoadHeadlessTexture(const std::string& filePath) {
+    if (filePath.ends_with(".png")) {
+        int width, height, channels;
+        if (!stbi_info(filePath.c_str(), &width, &height, &channels)) {
+            std::cerr << "stb_image Error (" << filePath << "): " << stbi_failure_reason() << std::endl;
+            return 0;
+        }
+        if (!get_gl_format(channels)) {
+            std::cerr << "Unsupported PNG channel count (" << filePath << "): " << channels << std::endl;
+            return 0;
+        }
+    } else if (filePath.ends_with(".bmp")) {
+        if (!std::filesystem::is_regular_file(filePath)) {
+            return 0;
+        }
+    } else {
+        std::cerr << "Unsupported file type: " << filePath << std::endl;
+        return 0;
+    }
+    return nextHeadlessTexture++;
+}
+
+void ReleaseTexture(GLuint textureID) {
+    if (!headlessTextures && textureID) {
+        auto it = textureBytes.find(textureID);
+        if (it != textureBytes.end()) {
+            textureMemory -= it->second;
+            textureBytes.erase(it);
+        }
+        releasedTextures.push_back(textureID);
+    }
+}
+
+void DeleteReleasedTextures() {
+    if (releasedTextures.empty()) {
+        return;
+    }
+    glDeleteTextures((GLsizei)releasedTextures.size(), releasedTextures.data());
+    releasedTextures.clear();
+}
+
 // Corrected version to fix color inversion
 GLuint LoadTexture(const std::string& filePath) {
+    QE_PROFILE_FUNCTION();
+    if (headlessTextures) {
+        return LoadHeadlessTexture(filePath);
+    }
+
     GLuint textureID;
+    int uploadedWidth = 0, uploadedHeight = 0;
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
 
@@ -57,6 +140,8 @@ GLuint LoadTexture(const std::string& filePath) {
 
         // Upload to GPU
         glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, imageData);
+        uploadedWidth = width;
+        uploadedHeight = height;
         glGenerateMipmap(GL_TEXTURE_2D);
 
         stbi_image_free(imageData);
@@ -104,6 +189,8 @@ GLuint LoadTexture(const std::string& filePath) {
 
         // Upload to GPU
         glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, surface->w, surface->h, 0, format, GL_UNSIGNED_BYTE, surface->pixels);
+        uploadedWidth = surface->w;
+        uploadedHeight = surface->h;
         glGenerateMipmap(GL_TEXTURE_2D);
 
         SDL_DestroySurface(surface);
@@ -124,5 +211,6 @@ GLuint LoadTexture(const std::string& filePath) {
     }
 
     glBindTexture(GL_TEXTURE_2D, 0);
+    TrackTexture(textureID, uploadedWidth, uploadedHeight);
     return textureID;
 }
@@ -0,0 +1,62 @@
+#include "../include/Timestep.h"
+#include <algorithm>
+
+FixedTimestep::FixedTimestep(float rate, int maxSteps)
+    : tickRate(60.0f), step(1.0f / 60.0f), accumulator(0.0f), maxStepsPerFrame(5) {
+    SetTickRate(rate);
+    SetMaxStepsPerFrame(maxSteps);
+}
+
+int FixedTimestep::Advance(float frameDelta) {
+    accumulator += std::max(frameDelta, 0.0f);
+
+    int steps = (int)(accumulator / step);
+    if (steps > maxStepsPerFrame) {
+        // Too far behind (long frame, breakpoint, window drag), drop the backlog instead of spiralling
+        steps = maxStepsPerFrame;
+        accumulator = 0.0f;
+        return steps;
+    }
+
+    accumulator -= steps * step;
+    return steps;
+}
+
+void FixedTimestep::SetTickRate(float rate) {
+    if (rate <= 0.0f) {
+        return;
+    }
+    tickRate = rate;
+    step = 1.0f / rate;
+    accumulator = std::min(accumulator, step);
+}
+
+void FixedTimestep::SetMaxStepsPerFrame(int maxSteps) {
+    maxStepsPerFrame = std::max(maxSteps, 1);
+}
+
+void InterpolateSprites(const SpriteStore& previous, const SpriteStore& current, float alpha,
+                        const std::vector<int>& visible, std::vector<Sprite>& out) {
+    out.resize(visible.size());
+
+    const float* lastX = previous.X();
+    const float* lastY = previous.Y();
+    const float* lastWidth = previous.Width();
+    const float* lastHeight = previous.Height();
+
+    for (size_t k = 0; k < visible.size(); k++) {
+        int i = visible[k];
+        Sprite& s = out[k];
+        s = current.Load(i);
+
+        // Sprites spawned this tick have no previous state and are drawn as-is
+        int last = previous.Find(current.HandleAt(i));
+        if (last < 0) {
+            continue;
+        }
+        s.x = lastX[last] + (s.x - lastX[last]) * alpha;
+        s.y = lastY[last] + (s.y - lastY[last]) * alpha;
+        s.width = lastWidth[last] + (s.width - lastWidth[last]) * alpha;
+        s.height = lastHeight[last] + (s.height - lastHeight[last]) * alpha;
+    }
+}
@@ -0,0 +1,255 @@
+#include "../include/Tween.h"
+#include "../include/Profiler.h"
+#include <cmath>
+#include <algorithm>
+
+std::vector<SlotHandle> TweenManager::spriteHandle;
+std::vector<int> TweenManager::tweenId;
+std::vector<int> TweenManager::waitFor;
+std::vector<TweenProperty> TweenManager::property;
+std::vector<EaseType> TweenManager::ease;
+std::vector<unsigned char> TweenManager::started;
+std::vector<float> TweenManager::from;
+std::vector<float> TweenManager::to;
+std::vector<float> TweenManager::elapsed;
+std::vector<float> TweenManager::duration;
+std::vector<float> TweenManager::delay;
+std::unordered_map<int, int> TweenManager::remaining;
+int TweenManager::nextTweenId = 1;
+
+static const float PI = 3.14159265358979f;
+
+static float BounceOut(float t) {
+    if (t < 1.0f / 2.75f) {
+        return 7.5625f * t * t;
+    } else if (t < 2.0f / 2.75f) {
+        t -= 1.5f / 2.75f;
+        return 7.5625f * t * t + 0.75f;
+    } else if (t < 2.5f / 2.75f) {
+        t -= 2.25f / 2.75f;
+        return 7.5625f * t * t + 0.9375f;
+    }
+    t -= 2.625f / 2.75f;
+    return 7.5625f * t * t + 0.984375f;
+}
+
+float ApplyEase(EaseType ease, float t) {
+    switch (ease) {
+        case EaseType::Linear:     return t;
+        case EaseType::QuadIn:     return t * t;
+        case EaseType::QuadOut:    return t * (2.0f - t);
+        case EaseType::QuadInOut:  return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+        case EaseType::CubicIn:    return t * t * t;
+        case EaseType::CubicOut:   { float f = t - 1.0f; return f * f * f + 1.0f; }
+        case EaseType::CubicInOut: {
+            if (t < 0.5f) return 4.0f * t * t * t;
+            float f = 2.0f * t - 2.0f;
+            return 0.5f * f * f * f + 1.0f;
+        }
+        case EaseType::SineIn:     return 1.0f - std::cos(t * PI * 0.5f);
+        case EaseType::SineOut:    return std::sin(t * PI * 0.5f);
+        case EaseType::SineInOut:  return 0.5f * (1.0f - std::cos(t * PI));
+        case EaseType::BackOut: {
+            const float c1 = 1.70158f;
+            const float c3 = c1 + 1.0f;
+            float f = t - 1.0f;
+            return 1.0f + c3 * f * f * f + c1 * f * f;
+        }
+        case EaseType::ElasticOut: {
+            if (t <= 0.0f || t >= 1.0f) return t;
+            return std::pow(2.0f, -10.0f * t) * std::sin((t * 10.0f - 0.75f) * (2.0f * PI / 3.0f)) + 1.0f;
+        }
+        case EaseType::BounceOut:  return BounceOut(t);
+    }
+    return t;
+}
+
+EaseType EaseFromName(const std::string& name) {
+    static const std::unordered_map<std::string, EaseType> names = {
+        {"linear", EaseType::Linear},
+        {"quadIn", EaseType::QuadIn}, {"quadOut", EaseType::QuadOut}, {"quadInOut", EaseType::QuadInOut},
+        {"cubicIn", EaseType::CubicIn}, {"cubicOut", EaseType::CubicOut}, {"cubicInOut", EaseType::CubicInOut},
+        {"sineIn", EaseType::SineIn}, {"sineOut", EaseType::SineOut}, {"sineInOut", EaseType::SineInOut},
+        {"backOut", EaseType::BackOut},
+        {"elasticOut", EaseType::ElasticOut},
+        {"bounceOut", EaseType::BounceOut}
+    };
+    auto it = names.find(name);
+    return it != names.end() ? it->second : EaseType::Linear;
+}
+
+// Tween properties index straight into the sprite store columns
+static_assert((int)TWEEN_X == (int)COLUMN_X && (int)TWEEN_A == (int)COLUMN_A &&
+              (int)TWEEN_PROPERTY_COUNT == (int)SPRITE_COLUMN_COUNT, "Tween properties must match sprite columns");
+
+int TweenManager::TweenTo(SlotHandle sprite, const TweenTarget& target, float tweenDuration,
+                          EaseType tweenEase, float tweenDelay, int after) {
+    if (sprite == INVALID_HANDLE || target.mask == 0) {
+        return 0;
+    }
+
+    // Chaining onto a tween that already finished just starts immediately
+    if (after != 0 && remaining.find(after) == remaining.end()) {
+        after = 0;
+    }
+
+    int id = nextTweenId++;
+    int count = 0;
+    for (int p = 0; p < TWEEN_PROPERTY_COUNT; p++) {
+        if (!(target.mask & (1u << p))) {
+            continue;
+        }
+        spriteHandle.push_back(sprite);
+        tweenId.push_back(id);
+        waitFor.push_back(after);
+        property.push_back(static_cast<TweenProperty>(p));
+        ease.push_back(tweenEase);
+        started.push_back(0);
+        from.push_back(0.0f);
+        to.push_back(target.values[p]);
+        elapsed.push_back(0.0f);
+        duration.push_back(std::max(tweenDuration, 0.0f));
+        delay.push_back(std::max(tweenDelay, 0.0f));
+        count++;
+    }
+
+    remaining[id] = count;
+    return id;
+}
+
+void TweenManager::Update(float deltaTime, SpriteStore& sprites) {
+    QE_PROFILE_SCOPE("TweenManager::Update");
+    size_t i = 0;
+    while (i < spriteHandle.size()) {
+        if (waitFor[i] != 0) {
+            i++;
+            continue;
+        }
+
+        int sprite = sprites.Find(spriteHandle[i]);
+        if (sprite < 0) {
+            // Sprite was destroyed out from under the tween
+            int id = tweenId[i];
+            RemoveRecord(i);
+            FinishRecord(id);
+            continue;
+        }
+
+        elapsed[i] += deltaTime;
+        float active = elapsed[i] - delay[i];
+        if (active < 0.0f) {
+            i++;
+            continue;
+        }
+
+        float& field = sprites.Column(static_cast<SpriteColumn>(property[i]))[sprite];
+        if (!started[i]) {
+            // Start value is captured when the tween actually begins so chains pick up where the last one ended
+            from[i] = field;
+            started[i] = 1;
+        }
+
+        float t = duration[i] > 0.0f ? std::min(active / duration[i], 1.0f) : 1.0f;
+        field = from[i] + (to[i] - from[i]) * ApplyEase(ease[i], t);
+
+        if (t >= 1.0f) {
+            int id = tweenId[i];
+            RemoveRecord(i);
+            FinishRecord(id);
+            continue;
+        }
+
+        i++;
+    }
+}
+
+bool TweenManager::IsTweenActive(int id) {
+    return remaining.find(id) != remaining.end();
+}
+
+void TweenManager::CancelTween(int id) {
+    size_t i = 0;
+    while (i < tweenId.size()) {
+        if (tweenId[i] == id) {
+            RemoveRecord(i);
+            FinishRecord(id);
+        } else {
+            i++;
+        }
+    }
+}
+
+void TweenManager::CancelSpriteTweens(SlotHandle sprite) {
+    size_t i = 0;
+    while (i < spriteHandle.size()) {
+        if (spriteHandle[i] == sprite) {
+            int id = tweenId[i];
+            RemoveRecord(i);
+            FinishRecord(id);
+        } else {
+            i++;
+        }
+    }
+}
+
+void TweenManager::ClearTweens() {
+    spriteHandle.clear();
+    tweenId.clear();
+    waitFor.clear();
+    property.clear();
+    ease.clear();
+    started.clear();
+    from.clear();
+    to.clear();
+    elapsed.clear();
+    duration.clear();
+    delay.clear();
+    remaining.clear();
+}
+
+// Swap-remove a record from every column
+void TweenManager::RemoveRecord(size_t i) {
+    size_t last = spriteHandle.size() - 1;
+    if (i != last) {
+        spriteHandle[i] = spriteHandle[last];
+        tweenId[i] = tweenId[last];
+        waitFor[i] = waitFor[last];
+        property[i] = property[last];
+        ease[i] = ease[last];
+        started[i] = started[last];
+        from[i] = from[last];
+        to[i] = to[last];
+        elapsed[i] = elapsed[last];
+        duration[i] = duration[last];
+        delay[i] = delay[last];
+    }
+    spriteHandle.pop_back();
+    tweenId.pop_back();
+    waitFor.pop_back();
+    property.pop_back();
+    ease.pop_back();
+    started.pop_back();
+    from.pop_back();
+    to.pop_back();
+    elapsed.pop_back();
+    duration.pop_back();
+    delay.pop_back();
+}
+
+// Called when one record of a tween is gone, releases chained tweens once all of them are
+void TweenManager::FinishRecord(int id) {
+    auto it = remaining.find(id);
+    if (it == remaining.end()) {
+        return;
+    }
+    if (--it->second > 0) {
+        return;
+    }
+    remaining.erase(it);
+
+    for (size_t i = 0; i < waitFor.size(); i++) {
+        if (waitFor[i] == id) {
+            waitFor[i] = 0;
+        }
+    }
+}
@@ -1,12 +1,21 @@
 #include "../include/UI.h"
 #include "../include/TextureLoader.h"
-#include "../include/Sprite.h"
+#include "../include/World.h"
 #include "../include/imgui.h"
 #include <iostream>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <fstream>
 #include "../include/AssetManager.h"
+#include "../include/LuaScripting.h"
+#include "../include/GpuProfiler.h"
+#include "../include/PerformanceStats.h"
+#include "../include/LuaGC.h"
+#include "../include/LuaProfiler.h"
+#include "../include/CoroutineScheduler.h"
+#include "../include/ScriptGroups.h"
+#include "../include/Systems.h"
 
 extern "C" {
 #include <lua.h>
@@ -18,7 +27,9 @@ extern lua_State* L;
 bool RunLuaFile(const std::string& filepath); // forward declaration
 
 #if GAME_MODE
-void RenderGUI(std::vector<Sprite>& sprites) {
+void RenderGUI(World& world) {
+    SpriteStore& sprites = world.sprites;
+
     // ==============================
     // Sprite Manager Window
     // ==============================
@@ -35,7 +46,7 @@ void RenderGUI(std::vector<Sprite>& sprites) {
                 std::string fullPath = AssetPath(pathBuffer); // resolve full path
                 GLuint tex = LoadTexture(fullPath.c_str());
                 if (tex) {
-                    sprites.push_back({tex, 100.0f, 100.0f, 128.0f, 128.0f});
+                    world.Spawn({tex, 100.0f, 100.0f, 128.0f, 128.0f});
                     std::cout << "Loaded texture: " << fullPath << std::endl;
                 } else {
                     std::cerr << "Failed to load texture: " << fullPath << std::endl;
@@ -53,15 +64,15 @@ void RenderGUI(std::vector<Sprite>& sprites) {
             for (size_t i = 0; i < sprites.size(); i++) {
                 ImGui::PushID((int)i);
 
-                ImGui::Text("Sprite %d", (int)i);
+                SlotHandle handle = sprites.HandleAt(i);
+                ImGui::Text("Sprite %llu", (unsigned long long)handle);
                 ImGui::SliderFloat("X", &sprites[i].x, 0.0f, 1920.0f);
                 ImGui::SliderFloat("Y", &sprites[i].y, 0.0f, 1080.0f);
                 ImGui::SliderFloat("Width", &sprites[i].width, 10.0f, 400.0f);
                 ImGui::SliderFloat("Height", &sprites[i].height, 10.0f, 400.0f);
 
                 if (ImGui::Button("Delete")) {
-                    glDeleteTextures(1, &sprites[i].textureID);
-                    sprites.erase(sprites.begin() + i);
+                    DestroyScriptSprite(L, handle);
                     ImGui::PopID();
                     break; // stop iterating after deletion
                 }
@@ -118,3 +129,89 @@ void RenderGUI(std::vector<Sprite>& sprites) {
     ImGui::End(); // End Build & Export
 }
 #endif
+
+// Lua sampling profiler controls, the bindings that took the most time listed below
+static void RenderLuaProfiler() {
+    static int mode = static_cast<int>(LuaSampleMode::Time);
+    static int interval = 1000;
+    static const int TOP_BINDINGS = 8;
+
+    bool running = LuaProfiler::IsRunning();
+    if (!running) {
+        ImGui::RadioButton("Per instructions", &mode, static_cast<int>(LuaSampleMode::Instructions));
+        ImGui::SameLine();
+        ImGui::RadioButton("Per microseconds", &mode, static_cast<int>(LuaSampleMode::Time));
+        ImGui::InputInt("Sample interval", &interval);
+    }
+    if (ImGui::Button(running ? "Stop Lua profiler" : "Start Lua profiler")) {
+        if (running) {
+            LuaProfiler::Stop(L);
+        } else {
+            LuaProfiler::Start(L, static_cast<LuaSampleMode>(mode), interval);
+        }
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear")) {
+        LuaProfiler::Clear();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Write flame graph")) {
+        LuaProfiler::WriteCollapsedStacks("lua_profile.folded");
+    }
+    ImGui::Text("Lua samples:    %llu", (unsigned long long)LuaProfiler::SampleCount());
+
+    std::vector<LuaBindingStats> bindings = LuaProfiler::Bindings();
+    std::sort(bindings.begin(), bindings.end(), [](const LuaBindingStats& a, const LuaBindingStats& b) {
+        return a.nanoseconds > b.nanoseconds;
+    });
+    for (int i = 0; i < TOP_BINDINGS && i < (int)bindings.size() && bindings[i].calls > 0; i++) {
+        ImGui::Text("%-22s %8.3f ms %8llu calls", bindings[i].name, bindings[i].nanoseconds / 1e6,
+                    (unsigned long long)bindings[i].calls);
+    }
+}
+
+void RenderPerformanceWindow(World& world) {
+    ImGui::Begin("Performance");
+
+    float average = PerformanceStats::AverageFrameTime();
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "%.2f ms (%.0f FPS)", average, average > 0.0f ? 1000.0f / average : 0.0f);
+    ImGui::PlotLines("Frame time", PerformanceStats::FrameTimes(), PerformanceStats::HISTORY,
+                     PerformanceStats::FrameTimeOffset(), overlay, 0.0f, 50.0f, ImVec2(0, 80));
+
+    ImGui::Separator();
+    ImGui::Text("Draw calls:     %u", PerformanceStats::DrawCalls());
+    ImGui::Text("Texture binds:  %u", PerformanceStats::TextureBinds());
+    ImGui::Text("Sprites:        %zu", world.sprites.size());
+    ImGui::Text("Culled:         %zu", RenderSystem::CulledCount());
+
+    ImGui::Separator();
+    ImGui::Text("Lua per frame:  %.3f ms", PerformanceStats::LuaMilliseconds());
+    ImGui::Text("Coroutines:     %zu", CoroutineScheduler::Count());
+    ImGui::Text("Script groups:  %zu", ScriptGroupManager::Count());
+    ImGui::Text("Lua heap:       %.1f KB", LuaGC::HeapKilobytes());
+    ImGui::Text("Lua GC:         %s, %d us budget",
+                LuaGC::Mode() == LuaGCMode::Generational ? "generational" : "incremental", LuaGC::StepBudget());
+    ImGui::Text("Idle GC:        %.3f ms (%d steps)", LuaGC::LastIdleMicroseconds() / 1000.0, LuaGC::LastStepCount());
+    ImGui::Text("Peak GC step:   %.1f us", LuaGC::PeakStepMicroseconds());
+    ImGui::SameLine();
+    if (ImGui::SmallButton("Reset")) {
+        LuaGC::ResetPeak();
+    }
+    ImGui::Text("GC cycles:      %llu", (unsigned long long)LuaGC::Cycles());
+    ImGui::Text("Texture memory: %.1f MB", GetTextureMemory() / (1024.0 * 1024.0));
+
+    ImGui::Separator();
+    RenderLuaProfiler();
+
+    ImGui::Separator();
+    const std::vector<GpuPassTiming>& timings = GpuProfiler::Timings();
+    if (timings.empty()) {
+        ImGui::Text("No GPU results yet");
+    }
+    for (const GpuPassTiming& timing : timings) {
+        ImGui::Text("GPU %-10s %6.3f ms  (avg %6.3f ms)", timing.name, timing.milliseconds, timing.average);
+    }
+
+    ImGui::End();
+}
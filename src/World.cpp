@@ -0,0 +1,4 @@
+#include "../include/World.h"
+
+// Define the global world **once**
+World world;
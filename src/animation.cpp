@@ -1,4 +1,6 @@
 #include "../include/animation.h"
+#include "../include/JobSystem.h"
+#include "../include/Profiler.h"
 
 std::vector<Animation> AnimationManager::animations;
 
@@ -84,6 +86,16 @@ void AnimationManager::UpdateAnimation(int animIndex, float deltaTime) {
     animations[animIndex].Update(deltaTime);
 }
 
+void AnimationManager::UpdateAllAnimations(float deltaTime) {
+    QE_PROFILE_SCOPE("AnimationManager::UpdateAllAnimations");
+    Animation* anims = animations.data();
+    JobSystem::ParallelFor(animations.size(), 256, [anims, deltaTime](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            anims[i].Update(deltaTime);
+        }
+    });
+}
+
 void AnimationManager::PlayAnimation(int animIndex) {
     if (animIndex < 0 || animIndex >= (int)animations.size()) {
         return;
@@ -1,7 +1,10 @@
 #include <iostream>
 #include <vector>
-#include <map>
 #include <filesystem>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
 
 // OpenGL
 #include <GL/glew.h>
@@ -28,31 +31,42 @@ extern "C" {
     #include <lauxlib.h>
     #include <lualib.h>
 }
+#include "../include/LuaCompat.h"
 
 // Project headers
 #include "../include/TextureLoader.h"
 #include "../include/UI.h"
-#include "../include/Sprite.h"
+#include "../include/World.h"
+#include "../include/Systems.h"
 #include "../include/Shader.h"
 #include "../include/CodeEditor.h"
 #include "../include/LuaScripting.h"
 #include "../include/AssetManager.h"
+#include "../include/Tween.h"
+#include "../include/Timestep.h"
+#include "../include/FramePipeline.h"
+#include "../include/JobSystem.h"
+#include "../include/FrameArena.h"
+#include "../include/AllocationCounter.h"
+#include "../include/Input.h"
+#include "../include/InputRecorder.h"
+#include "../include/OffscreenContext.h"
+#include "../include/Profiler.h"
+#include "../include/GpuProfiler.h"
+#include "../include/PerformanceStats.h"
+#include "../include/LuaGC.h"
+#include "../include/CoroutineScheduler.h"
+#include "../include/ScriptSystem.h"
+#include "../include/ScriptGroups.h"
 
 // Global state
 CodeEditor luaEditor;
-std::vector<Sprite> sprites;
-
-void processInput(GLFWwindow* window, std::map<int, bool>& keyPresses) {
-    for (int key = GLFW_KEY_SPACE; key < GLFW_KEY_LAST; key++) {
-        if (glfwGetKey(window, key) == GLFW_PRESS && !keyPresses[key]) {
-            keyPresses[key] = true;
-        } else if (glfwGetKey(window, key) == GLFW_RELEASE) {
-            keyPresses[key] = false;
-        }
-    }
-}
+FixedTimestep simulationTimestep(60.0f, 5);
 
 void updateLua(float deltaTime) {
+    QE_PROFILE_FUNCTION();
+    auto luaStart = std::chrono::steady_clock::now();
+
     // Call Lua Update function if it exists
     lua_getglobal(L, "Update");
     if (lua_type(L, -1) == LUA_TFUNCTION) {
@@ -65,21 +79,16 @@ void updateLua(float deltaTime) {
         lua_pop(L, 1);
     }
 
-    // Resume coroutine if it exists
-    lua_getglobal(L, "MoveCoroutine");
-    if (lua_type(L, -1) == LUA_TTHREAD) {
-        lua_State* co = lua_tothread(L, -1);
-        int nresults = 0;
-        int status = lua_resume(co, nullptr, 0, &nresults);
-        if (status != LUA_OK && status != LUA_YIELD) {
-            std::cerr << "Coroutine error: " << lua_tostring(co, -1) << std::endl;
-            lua_pop(co, 1);
-        }
-    }
-    lua_pop(L, 1);
+    // Per-entity scripts
+    ScriptSystem::Update(L, world, deltaTime);
+
+    // Resume the script coroutines due this tick
+    CoroutineScheduler::Update(L, deltaTime);
+
+    PerformanceStats::AddLuaTime(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - luaStart).count());
 }
 
-bool initializeOpenGL(GLFWwindow*& window) {
+bool initializeOpenGL(GLFWwindow*& window, bool visible = true) {
     // Initialize GLFW
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW" << std::endl;
@@ -91,8 +100,14 @@ bool initializeOpenGL(GLFWwindow*& window) {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-    // Create window
-    window = glfwCreateWindow(1920, 1080, "QEngine - 2D Game Engine", glfwGetPrimaryMonitor(), nullptr);
+    // Create window, replays run in a hidden window as fast as they can
+    if (visible) {
+        window = glfwCreateWindow(1920, 1080, "QEngine - 2D Game Engine", glfwGetPrimaryMonitor(), nullptr);
+    } else {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        window = glfwCreateWindow(1920, 1080, "QEngine - 2D Game Engine", nullptr, nullptr);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    }
     if (!window) {
         std::cerr << "Failed to create GLFW window" << std::endl;
         glfwTerminate();
@@ -100,7 +115,7 @@ bool initializeOpenGL(GLFWwindow*& window) {
     }
 
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(1); // Enable vsync
+    glfwSwapInterval(visible ? 1 : 0); // Enable vsync
 
     // Initialize GLEW
     glewExperimental = GL_TRUE;
@@ -123,6 +138,18 @@ bool initializeOpenGL(GLFWwindow*& window) {
     return true;
 }
 
+// Hidden window whose context shares textures with the main one, used by the simulation thread
+GLFWwindow* createLoaderContext(GLFWwindow* window) {
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* loader = glfwCreateWindow(1, 1, "QEngine Loader", nullptr, window);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+    if (!loader) {
+        std::cerr << "Failed to create loader context, falling back to serial frames" << std::endl;
+    }
+    return loader;
+}
+
 bool setupQuadGeometry(GLuint& VAO, GLuint& VBO, GLuint& EBO) {
     // Quad vertices: position (2) + texcoords (2)
     float vertices[] = {
@@ -191,8 +218,15 @@ bool initializeImGui(GLFWwindow* window) {
 }
 
 void renderSprites(Shader& shader, GLuint VAO, const std::vector<Sprite>& sprites) {
+    QE_PROFILE_FUNCTION();
     shader.use();
     glBindVertexArray(VAO);
+    glActiveTexture(GL_TEXTURE0);
+    shader.setInt("spriteTexture", 0);
+
+    // Consecutive sprites often share a texture, only rebind when it changes
+    bool textureBound = false;
+    GLuint boundTexture = 0;
 
     for (const auto& sprite : sprites) {
         // Create model matrix
@@ -201,25 +235,31 @@ void renderSprites(Shader& shader, GLuint VAO, const std::vector<Sprite>& sprite
         model = glm::scale(model, glm::vec3(sprite.width, sprite.height, 1.0f));
 
         shader.setMat4("model", glm::value_ptr(model));
+        shader.setVec4("spriteColor", sprite.r, sprite.g, sprite.b, sprite.a);
 
         // Bind texture
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, sprite.textureID);
-        shader.setInt("spriteTexture", 0);  // Use 'shader' not 'spriteShader'
+        if (!textureBound || sprite.textureID != boundTexture) {
+            glBindTexture(GL_TEXTURE_2D, sprite.textureID);
+            boundTexture = sprite.textureID;
+            textureBound = true;
+            PerformanceStats::CountTextureBind();
+        }
 
         // Draw
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        PerformanceStats::CountDrawCall();
     }
 
     glBindVertexArray(0);
 }
 
-void cleanup(GLuint VAO, GLuint VBO, GLuint EBO, std::vector<Sprite>& sprites) {
+void cleanup(GLuint VAO, GLuint VBO, GLuint EBO, World& world) {
+    GpuProfiler::Shutdown();
+
     // Delete all sprite textures
-    for (auto& sprite : sprites) {
-        glDeleteTextures(1, &sprite.textureID);
-    }
-    sprites.clear();
+    DeleteReleasedTextures();
+    glDeleteTextures((GLsizei)world.sprites.size(), world.sprites.TextureIDs());
+    world.Clear();
 
     // Delete OpenGL objects
     glDeleteVertexArrays(1, &VAO);
@@ -234,21 +274,257 @@ void cleanup(GLuint VAO, GLuint VBO, GLuint EBO, std::vector<Sprite>& sprites) {
     // Shutdown Lua
     shutdownLua();
 
+    // Stop job system workers
+    JobSystem::Shutdown();
+
     std::cout << "Cleanup complete" << std::endl;
 }
 
+// Sprite state at the previous tick, used to blend the snapshot between ticks
+SpriteStore previousSprites;
+
+// Screen region matching the projection, padded so sprites moving in from the edge
+// are not culled on the tick before they become visible
+const float cullMargin = 64.0f;
+const AABB viewRegion(-cullMargin, -cullMargin, 1920.0f + 2.0f * cullMargin, 1080.0f + 2.0f * cullMargin);
+
+// With a simulation thread its idle time starts right after the snapshot is published,
+// otherwise the main loop runs the Lua GC step after rendering
+bool gcAfterSimulation = false;
+
+// Simulation stage: fixed ticks of Lua, tweens and systems, then publish a culled, interpolated snapshot
+void simulateFrame(float deltaTime, RenderSnapshot& out) {
+    QE_PROFILE_FUNCTION();
+    // Transient buffers from the last frame are dead by now
+    frameArena.Reset();
+    AllocationCounter::BeginFrame();
+
+    int steps = simulationTimestep.Advance(deltaTime);
+    for (int tick = 0; tick < steps; tick++) {
+        QE_PROFILE_SCOPE("Tick");
+        float step = simulationTimestep.GetStep();
+        previousSprites = world.sprites;
+
+        // Update Lua scripts
+        updateLua(step);
+        ScriptGroupManager::Update(L, step);
+
+        // Advance tweens started from scripts
+        TweenManager::Update(step, world.sprites);
+
+        // Component systems
+        MovementSystem::Update(world, step);
+        AnimationSystem::Update(world, step);
+        CollisionSystem::Update(world);
+        ScriptSystem::DispatchCollisions(L, world);
+
+        // This tick has seen the key edges
+        InputManager::EndTick();
+    }
+
+    RenderSystem::BuildRenderList(world, previousSprites, simulationTimestep.GetAlpha(), viewRegion, out.sprites);
+    AllocationCounter::EndFrame();
+    PerformanceStats::EndSimulationFrame();
+
+    if (gcAfterSimulation) {
+        LuaGC::Step(L);
+    }
+}
+
+// Seed Lua's math.random so recorded sessions replay the same rolls
+void seedLuaRandom(uint32_t seed) {
+    lua_getglobal(L, "math");
+    lua_getfield(L, -1, "randomseed");
+    lua_pushinteger(L, (lua_Integer)seed);
+    if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+        std::cerr << "Failed to seed Lua random: " << lua_tostring(L, -1) << std::endl;
+        lua_pop(L, 1);
+    }
+    lua_pop(L, 1);
+}
+
+void runMainScript() {
+    QE_PROFILE_FUNCTION();
+    std::string mainScriptPath = (assetFolder / "scripts" / "main.lua").string();
+
+    std::cout << "Running game script: " << mainScriptPath << std::endl;
+
+    if (luaL_dofile(L, mainScriptPath.c_str()) != LUA_OK) {
+        std::cerr << "Lua runtime error: " << lua_tostring(L, -1) << std::endl;
+        lua_pop(L, 1);
+    }
+}
+
+// No window or ImGui. Runs 'frames' frames at a fixed 60 Hz delta (or the recorded
+// deltas when replaying) as fast as possible. Without 'offscreen' there is no GL
+// context at all; with it every frame is drawn into an EGL framebuffer and, if
+// dumpFolder is set, written out as frame_NNNNN.png.
+int runHeadless(int frames, bool offscreen, const std::string& dumpFolder) {
+    OffscreenContext target;
+    GLuint VAO = 0, VBO = 0, EBO = 0;
+    std::unique_ptr<Shader> spriteShader;
+    if (offscreen) {
+        if (!target.Create(1920, 1080) || !setupQuadGeometry(VAO, VBO, EBO)) {
+            return -1;
+        }
+        spriteShader = std::make_unique<Shader>("sprite.vert", "sprite.frag");
+        spriteShader->use();
+        glm::mat4 projection = glm::ortho(0.0f, 1920.0f, 1080.0f, 0.0f, -1.0f, 1.0f);
+        spriteShader->setMat4("projection", glm::value_ptr(projection));
+        spriteShader->setVec4("spriteColor", 1.0f, 1.0f, 1.0f, 1.0f);
+        GpuProfiler::Initialize();
+    } else {
+        SetHeadlessTextures(true);
+    }
+
+    JobSystem::Initialize();
+    initLua();
+    registerLuaFunctions();
+
+    bool trackChecksums = InputRecorder::IsReplaying() || InputRecorder::IsRecording();
+    if (trackChecksums) {
+        seedLuaRandom(InputRecorder::GetSeed());
+    }
+
+    runMainScript();
+    previousSprites = world.sprites;
+
+    RenderSnapshot snapshot;
+    int frame = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (frames < 0 || frame < frames) {
+        // Last frame's snapshot is drawn, nothing references its released textures now
+        DeleteReleasedTextures();
+        float deltaTime = 1.0f / 60.0f;
+        if (!InputRecorder::BeginFrame(deltaTime)) {
+            break;
+        }
+        InputManager::BeginFrame();
+        simulateFrame(deltaTime, snapshot);
+        if (trackChecksums) {
+            InputRecorder::EndFrame(world.sprites.Checksum());
+        }
+
+        if (offscreen) {
+            GpuProfiler::BeginFrame();
+            target.Bind();
+            glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            {
+                GpuPassScope pass("Sprites");
+                renderSprites(*spriteShader, VAO, snapshot.sprites);
+            }
+            GpuProfiler::EndFrame();
+
+            if (!dumpFolder.empty()) {
+                char name[32];
+                snprintf(name, sizeof(name), "frame_%05d.png", frame);
+                target.SavePNG((fs::path(dumpFolder) / name).string());
+            } else {
+                // Count the GPU work in the frame time
+                glFinish();
+            }
+        }
+        LuaGC::Step(L);
+        frame++;
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << (offscreen ? "Offscreen: " : "Headless: ") << frame << " frames in " << elapsed << " s ("
+              << (frame ? elapsed * 1000.0 / frame : 0.0) << " ms/frame), "
+              << world.sprites.size() << " sprites, checksum " << std::hex << world.sprites.Checksum()
+              << std::dec << std::endl;
+    for (const GpuPassTiming& timing : GpuProfiler::Timings()) {
+        std::cout << "  GPU " << timing.name << ": " << timing.average << " ms average" << std::endl;
+    }
+
+    InputRecorder::Stop();
+    if (offscreen) {
+        GpuProfiler::Shutdown();
+        DeleteReleasedTextures();
+        glDeleteTextures((GLsizei)world.sprites.size(), world.sprites.TextureIDs());
+        glDeleteVertexArrays(1, &VAO);
+        glDeleteBuffers(1, &VBO);
+        glDeleteBuffers(1, &EBO);
+        spriteShader.reset();
+    }
+    world.Clear();
+    shutdownLua();
+    JobSystem::Shutdown();
+    return 0;
+}
+
 int main(int argc, char** argv) {
-    // Set asset folder from command line argument
-    if (argc > 1) {
-        assetFolder = argv[1];
+    // Usage: QEngine [assetFolder] [--record file | --replay file]
+    //                [--headless | --offscreen [--dump folder]] [--frames N] [--trace file]
+    QE_PROFILE_THREAD("Main");
+    std::string tracePath;
+    std::string recordPath;
+    std::string replayPath;
+    std::string dumpFolder;
+    bool headless = false;
+    bool offscreen = false;
+    int headlessFrames = -1;
+    bool assetFolderSet = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--offscreen") {
+            offscreen = true;
+        } else if (arg == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (arg == "--dump" && i + 1 < argc) {
+            dumpFolder = argv[++i];
+        } else if (arg == "--frames" && i + 1 < argc) {
+            headlessFrames = std::atoi(argv[++i]);
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (!assetFolderSet) {
+            assetFolder = arg;
+            assetFolderSet = true;
+        }
+    }
+
+    if (assetFolderSet) {
         std::cout << "Asset folder set to: " << assetFolder << std::endl;
     } else {
         std::cout << "Using default asset folder: " << assetFolder << std::endl;
     }
 
+    // Input has to be recorded from the very first event
+    if (!replayPath.empty()) {
+        if (!InputRecorder::StartReplay(replayPath)) {
+            return -1;
+        }
+    } else if (!recordPath.empty()) {
+        if (!InputRecorder::StartRecording(recordPath, std::random_device{}())) {
+            return -1;
+        }
+    }
+    bool replaying = InputRecorder::IsReplaying();
+    bool trackChecksums = replaying || InputRecorder::IsRecording();
+
+    if (headless || offscreen) {
+        // Without a replay there is nothing to end the run, so default to ten seconds of frames
+        if (headlessFrames < 0 && !replaying) {
+            headlessFrames = 600;
+        }
+        if (!dumpFolder.empty()) {
+            fs::create_directories(dumpFolder);
+        }
+        int result = runHeadless(headlessFrames, offscreen && !headless, dumpFolder);
+        if (!tracePath.empty()) {
+            Profiler::WriteChromeTrace(tracePath);
+        }
+        return result;
+    }
+
     // Initialize OpenGL and create window
     GLFWwindow* window = nullptr;
-    if (!initializeOpenGL(window)) {
+    if (!initializeOpenGL(window, !replaying)) {
         return -1;
     }
 
@@ -272,99 +548,178 @@ int main(int argc, char** argv) {
     spriteShader.setVec4("spriteColor", 1.0f, 1.0f, 1.0f, 1.0f);
 
     std::cout << "Shaders loaded and projection matrix set" << std::endl;
+    GpuProfiler::Initialize();
+    // Input callbacks go in first, ImGui's backend chains to whatever is installed
+    InputManager::Install(window);
+
     // Initialize ImGui
     if (!initializeImGui(window)) {
-        cleanup(VAO, VBO, EBO, sprites);
+        cleanup(VAO, VBO, EBO, world);
         glfwDestroyWindow(window);
         glfwTerminate();
         return -1;
     }
 
+    // Start the shared job system before anything submits work
+    JobSystem::Initialize();
+
     // Initialize Lua
     initLua();
     registerLuaFunctions();
     SetLuaWindow(window);
+    if (trackChecksums) {
+        seedLuaRandom(InputRecorder::GetSeed());
+    }
 
     std::cout << "All systems initialized. Starting main loop..." << std::endl;
     #if !GAME_MODE
-
-    std::string mainScriptPath = (assetFolder / "scripts" / "main.lua").string();
-
-    std::cout << "Running game script: " << mainScriptPath << std::endl;
-
-    if (luaL_dofile(L, mainScriptPath.c_str()) != LUA_OK) {
-        std::cerr << "Lua runtime error: " << lua_tostring(L, -1) << std::endl;
-        lua_pop(L, 1);
-    }
+    runMainScript();
     #endif
-    // Setup input tracking
-    std::map<int, bool> keyPresses;
-
     // Asset folder input buffer
     static char folderInput[512];
     strncpy(folderInput, assetFolder.string().c_str(), sizeof(folderInput) - 1);
     folderInput[sizeof(folderInput) - 1] = '\0';
 
+    // Blend the first frame against the state the script set up
+    previousSprites = world.sprites;
+
+    FramePipeline pipeline;
+    GLFWwindow* loaderWindow = PIPELINED_FRAMES ? createLoaderContext(window) : nullptr;
+    pipeline.Start(simulateFrame, loaderWindow != nullptr, loaderWindow);
+    gcAfterSimulation = pipeline.IsThreaded();
+
     // Timing
     double lastTime = glfwGetTime();
+    double startTime = lastTime;
+    bool frameInFlight = false;
 
     // Main loop
     while (!glfwWindowShouldClose(window)) {
+        QE_PROFILE_SCOPE("Frame");
+
+        // Wait for the previous frame's simulation, it is idle until the next Kick
+        {
+            QE_PROFILE_SCOPE("WaitForSimulation");
+            pipeline.Wait();
+        }
+        // Textures released since the last Wait were in the snapshot drawn last frame at most,
+        // the one just published was built without them
+        DeleteReleasedTextures();
+        if (trackChecksums && frameInFlight) {
+            InputRecorder::EndFrame(world.sprites.Checksum());
+        }
+
+        // Input callbacks fire in here. They only write the live input state, which
+        // InputManager::BeginFrame hands to the simulation right before Kick.
+        {
+            QE_PROFILE_SCOPE("PollEvents");
+            glfwPollEvents();
+        }
+
         // Calculate delta time
         double currentTime = glfwGetTime();
         float deltaTime = static_cast<float>(currentTime - lastTime);
         lastTime = currentTime;
+        PerformanceStats::RecordFrameTime(deltaTime * 1000.0f);
 
-        // Process input
-        processInput(window, keyPresses);
+        #if GAME_MODE
+        // Build the editor UI while the simulation is idle, it edits sprites and runs Lua
+        {
+            QE_PROFILE_SCOPE("EditorUI");
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            ImGui::NewFrame();
+
+            // Render GUI
+            RenderGUI(world);
+            RenderPerformanceWindow(world);
+            RenderCodeEditor(luaEditor, "Lua Script Editor");
+
+            // Run script button
+            if (ImGui::Button("Run Script")) {
+                std::string code = luaEditor.editor.GetText();
+                if (luaL_dostring(L, code.c_str()) != LUA_OK) {
+                    std::cerr << "Lua error: " << lua_tostring(L, -1) << std::endl;
+                    lua_pop(L, 1);
+                }
+            }
 
-        // Update Lua scripts
-        updateLua(deltaTime);
+            // Project path input
+            ImGui::InputText("Project Path", folderInput, sizeof(folderInput));
+            if (ImGui::Button("Set Project Path")) {
+                assetFolder = folderInput;
+                std::cout << "Project path set to: " << assetFolder << std::endl;
+            }
+
+            ImGui::Render();
+        }
+        #endif
+
+        // Log this frame's input and dt, or swap in the recorded ones
+        if (!InputRecorder::BeginFrame(deltaTime)) {
+            break;
+        }
+        InputManager::BeginFrame();
+
+        // Simulate the next frame while this one is submitted
+        const RenderSnapshot& snapshot = pipeline.Current();
+        pipeline.Kick(deltaTime);
+        frameInFlight = true;
+
+        GpuProfiler::BeginFrame();
+        PerformanceStats::BeginRender();
 
         // Clear screen
         glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        // Render sprites
-        renderSprites(spriteShader, VAO, sprites);
+        // Render the published snapshot
+        {
+            GpuPassScope pass("Sprites");
+            renderSprites(spriteShader, VAO, snapshot.sprites);
+        }
         #if GAME_MODE
-        // Start ImGui frame
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
-
-        // Render GUI
-        RenderGUI(sprites);
-        RenderCodeEditor(luaEditor, "Lua Script Editor");
-
-        // Run script button
-        if (ImGui::Button("Run Script")) {
-            std::string code = luaEditor.editor.GetText();
-            if (luaL_dostring(L, code.c_str()) != LUA_OK) {
-                std::cerr << "Lua error: " << lua_tostring(L, -1) << std::endl;
-                lua_pop(L, 1);
-            }
+        // Render ImGui
+        {
+            QE_PROFILE_SCOPE("ImGuiRender");
+            GpuPassScope pass("ImGui");
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         }
+        #endif
+        GpuProfiler::EndFrame();
 
-        // Project path input
-        ImGui::InputText("Project Path", folderInput, sizeof(folderInput));
-        if (ImGui::Button("Set Project Path")) {
-            assetFolder = folderInput;
-            std::cout << "Project path set to: " << assetFolder << std::endl;
+        // Spend the GC budget while the GPU works through the frame
+        if (!gcAfterSimulation) {
+            LuaGC::Step(L);
         }
 
-        // Render ImGui
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-        #endif
-
-        // Swap buffers and poll events
+        // Swap buffers
+        QE_PROFILE_SCOPE("SwapBuffers");
         glfwSwapBuffers(window);
-        glfwPollEvents();
+    }
+
+    pipeline.Wait();
+    if (trackChecksums && frameInFlight) {
+        InputRecorder::EndFrame(world.sprites.Checksum());
+    }
+    if (replaying) {
+        double elapsed = glfwGetTime() - startTime;
+        uint64_t frames = InputRecorder::FrameCount();
+        std::cout << "Replay took " << elapsed << " s (" << (frames ? elapsed * 1000.0 / frames : 0.0)
+                  << " ms/frame)" << std::endl;
+    }
+    InputRecorder::Stop();
+    if (!tracePath.empty()) {
+        Profiler::WriteChromeTrace(tracePath);
+    }
+
+    pipeline.Stop();
+    if (loaderWindow) {
+        glfwDestroyWindow(loaderWindow);
     }
 
     // Cleanup
-    cleanup(VAO, VBO, EBO, sprites);
+    cleanup(VAO, VBO, EBO, world);
     glfwDestroyWindow(window);
     glfwTerminate();
 